@@ -30,8 +30,16 @@
 
 #include <iostream>
 
+// SSE2 is always available on x86-64, and optionally on 32 bit x86
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP>= 2)
+#ifndef HAVE_SSE2
+#define HAVE_SSE2
+#endif
+#endif
 
 #include "Errors.hh"
+#include "Types.hh"
 #include "CommandlineParser.hh"
 
 namespace MDA {
@@ -77,10 +85,19 @@ namespace MDA {
   /** swap endianness (in place) */
   void *swapByteOrder( void *bytes, unsigned numBytes );
 
-  /** swap the endianness of a whole array (in place) */
+  /** swap the endianness of a whole array (in place)
+      (2, 4, and 8 byte entries use vectorized code paths) */
   void *swapArrayByteOrder( void *bytes, unsigned long entries,
 			    unsigned bytesPerEntry );
 
+  /** convert one or more values stored in the opposite byte order to
+      another data type (in native byte order). This is equivalent to
+      swapArrayByteOrder followed by typeConvert, but works in a
+      single pass and does not modify the input memory */
+  void swapTypeConvert( void *fromMem, DataType fromType,
+			void *toMem, DataType toType,
+			unsigned long count= 1 );
+
   /** is a given number a power of two? */
   bool isPowerOf2( unsigned long val );
 
@@ -0,0 +1,383 @@
+// ==========================================================================
+// $Id:$
+// chunked, compressed variant of the MDA file format with random access
+// ==========================================================================
+// License: Internal use at UBC only! External use is a copyright violation!
+// ==========================================================================
+// (C)opyright:
+//
+// 2007-, UBC
+//
+// Creator: heidrich (Wolfgang Heidrich)
+// Email:   heidrich@cs.ubc.ca
+// ==========================================================================
+
+#ifndef BASE_CHUNKEDMDAFILE_H
+#define BASE_CHUNKEDMDAFILE_H
+
+/*! \file  ChunkedMDAFile.hh
+    \brief chunked, compressed variant of the MDA file format with
+    random access
+ */
+
+#if defined(_WIN32) || defined(_WIN64)
+// this header file must be included before all the others
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <stdint.h>
+
+#include "Types.hh"
+#include "BitsAndBytes.hh"
+#include "CoordinateVector.hh"
+#include "CommandlineParser.hh"
+
+namespace MDA {
+
+  using namespace std;
+
+  /** compression methods for the chunks of a chunked MDA file
+      (ZStd and LZ4 are only available if the library was compiled
+      with HAVE_ZSTD or HAVE_LZ4, respectively) */
+  enum ChunkCompression
+  {
+    NoChunkCompression,
+    ZStdChunkCompression,
+    LZ4ChunkCompression
+  };
+
+  /** write chunk compression method to ostream */
+  ostream &operator<<( ostream &os, ChunkCompression compression );
+
+  /** read chunk compression method from istream */
+  istream &operator>>( istream &is, ChunkCompression &compression );
+
+  /** is a given compression method compiled into the library? */
+  bool chunkCompressionAvailable( ChunkCompression compression );
+
+  /** compress one chunk into dst (which must be at least
+      chunkCompressionBound(srcSize) bytes large). Returns the
+      compressed size, or 0 if the data could not be compressed into
+      less space than the raw data (reentrant) */
+  unsigned long compressChunk( ChunkCompression compression, int level,
+			       const void *src, unsigned long srcSize,
+			       void *dst, unsigned long dstSize );
+
+  /** upper bound for the output size of compressChunk */
+  unsigned long chunkCompressionBound( ChunkCompression compression,
+				       unsigned long srcSize );
+
+  /** decompress one chunk of known raw size (reentrant) */
+  bool decompressChunk( ChunkCompression compression,
+			const void *src, unsigned long srcSize,
+			void *dst, unsigned long dstSize );
+
+
+  /** \class ChunkedMDAWriter ChunkedMDAFile.hh
+      writer for chunked MDA files.
+
+      A chunked MDA file has the same header fields as a regular MDA
+      file (with a different signature line so that readers for the
+      plain format reject it), plus a "Chunks:" line specifying the
+      compression method, the number of scanlines per chunk, and the
+      number of chunks. The header is followed by an index of
+      numChunks+1 little endian 64 bit offsets (relative to the end of
+      the index), and then by the chunks themselves. Every chunk is
+      compressed independently; chunks that do not compress are
+      stored raw, which is recognizable from the chunk size in the
+      index. Since the index is filled in by close(), the output must
+      be a seekable file.
+
+      The chunks are compressed in batches by compressChunks(), which
+      subclasses can override to compress the chunks of a batch in
+      parallel (see ParallelChunkedMDAWriter in the Threading
+      library). The base class uses batches of a single chunk.
+  */
+  class ChunkedMDAWriter {
+
+  public:
+
+    /** constructor */
+    ChunkedMDAWriter( ChunkCompression compression= ZStdChunkCompression,
+		      int level= 3, unsigned long scanlinesPerChunk= 0 );
+
+    /** destructor (closes the file if required) */
+    virtual ~ChunkedMDAWriter();
+
+    /** open a file and write the header (scanlinesPerChunk==0 selects
+	a chunk size of roughly 1MB) */
+    bool open( const char *fileName, const CoordinateVector &dim,
+	       unsigned numChannels, DataType type );
+
+    /** write the index and close the file */
+    bool close();
+
+    /** append one scanline */
+    bool writeScanline( const void *scanline );
+
+    /** append several consecutive scanlines */
+    bool writeScanlines( const void *scanlines, unsigned long count );
+
+    /** size of one scanline in bytes */
+    inline unsigned long getScanlineSize() const
+    {
+      return scanlineSize;
+    }
+
+  protected:
+
+    /** compress the buffered chunks and append them to the file */
+    bool flushChunks();
+
+    /** compress the first count chunks of the chunk buffer into
+	compressedBuffer, and store their sizes in compressedSizes
+	(serial version) */
+    virtual void compressChunks( unsigned long count );
+
+    /** raw size of the given chunk in the chunk buffer */
+    unsigned long bufferedChunkSize( unsigned long chunk ) const;
+
+    /** compression method */
+    ChunkCompression compression;
+
+    /** compression level */
+    int level;
+
+    /** the output file */
+    ofstream os;
+
+    /** number of scanlines per chunk requested in the constructor
+	(0 for automatic) */
+    unsigned long requestedScanlines;
+
+    /** number of scanlines per chunk */
+    unsigned long chunkScanlines;
+
+    /** number of chunks buffered before they are compressed */
+    unsigned long batchChunks;
+
+    /** size of one scanline in bytes */
+    unsigned long scanlineSize;
+
+    /** total number of scanlines in the file */
+    unsigned long numScanlines;
+
+    /** number of scanlines written so far */
+    unsigned long scanlinesWritten;
+
+    /** number of scanlines currently in the chunk buffer */
+    unsigned long bufferedScanlines;
+
+    /** file offset of the chunk index */
+    uint64_t indexOffset;
+
+    /** chunk offsets relative to the end of the index (64 bit, since
+	unsigned long only has 32 bits on Win64) */
+    vector<uint64_t> chunkOffsets;
+
+    /** uncompressed data of the current batch of chunks */
+    vector<char> chunkBuffer;
+
+    /** compressed data of the current batch of chunks */
+    vector<char> compressedBuffer;
+
+    /** space reserved for every chunk in compressedBuffer */
+    unsigned long compressedChunkSize;
+
+    /** compressed sizes of the chunks in the batch (0 for raw) */
+    vector<unsigned long> compressedSizes;
+  };
+
+
+  /** \class ChunkedMDAReader ChunkedMDAFile.hh
+      reader for chunked MDA files.
+
+      Any range of scanlines can be read without decompressing the
+      chunks in front of it. The most recently decompressed batch of
+      chunks is cached, so sequential access with readScanline()
+      decompresses every chunk exactly once. Like the writer, the
+      base class uses batches of a single chunk, and subclasses can
+      override decompressChunks() to decode a batch in parallel.
+  */
+  class ChunkedMDAReader {
+
+  public:
+
+    /** default constructor */
+    ChunkedMDAReader();
+
+    /** destructor */
+    virtual ~ChunkedMDAReader() {}
+
+    /** check whether a file is a chunked MDA file */
+    static bool isChunked( const char *fileName );
+
+    /** open a file and read the header and the chunk index */
+    bool open( const char *fileName );
+
+    /** close the file */
+    void close();
+
+    /** whether a file is currently open */
+    inline bool isOpen() const
+    {
+      return is.is_open();
+    }
+
+    /** data type */
+    inline DataType getType() const
+    {
+      return type;
+    }
+
+    /** array dimensions */
+    inline const CoordinateVector &getDim() const
+    {
+      return dim;
+    }
+
+    /** number of channels */
+    inline unsigned getNumChannels() const
+    {
+      return numChannels;
+    }
+
+    /** total number of scanlines */
+    inline unsigned long getNumScanlines() const
+    {
+      return numScanlines;
+    }
+
+    /** number of scanlines not yet read by readScanline() */
+    inline unsigned long getNumScanlinesLeft() const
+    {
+      return numScanlines-currentScanline;
+    }
+
+    /** size of one scanline in bytes */
+    inline unsigned long getScanlineSize() const
+    {
+      return scanlineSize;
+    }
+
+    /** compression method of the file */
+    inline ChunkCompression getCompression() const
+    {
+      return compression;
+    }
+
+    /** read a range of scanlines into a buffer of count*scanlineSize
+	bytes (random access) */
+    bool readScanlines( unsigned long first, unsigned long count,
+			void *buffer );
+
+    /** read the next scanline into a buffer (sequential access) */
+    bool readScanline( void *buffer );
+
+    /** set the position used by readScanline() */
+    inline void seekScanline( unsigned long scanline )
+    {
+      currentScanline= scanline;
+    }
+
+  protected:
+
+    /** make sure the given chunk is in the chunk cache */
+    bool loadChunk( unsigned long chunk );
+
+    /** decompress count chunks starting at the given one from
+	compressedBuffer into the chunk buffer (serial version) */
+    virtual bool decompressChunks( unsigned long first,
+				   unsigned long count );
+
+    /** raw size of the given chunk of the file */
+    unsigned long chunkRawSize( unsigned long chunk ) const;
+
+    /** the input file */
+    ifstream is;
+
+    /** data type */
+    DataType type;
+
+    /** array dimensions */
+    CoordinateVector dim;
+
+    /** number of channels */
+    unsigned numChannels;
+
+    /** compression method */
+    ChunkCompression compression;
+
+    /** number of scanlines per chunk */
+    unsigned long chunkScanlines;
+
+    /** maximum number of chunks decompressed at a time */
+    unsigned long batchChunks;
+
+    /** size of one scanline in bytes */
+    unsigned long scanlineSize;
+
+    /** total number of scanlines */
+    unsigned long numScanlines;
+
+    /** position for sequential reading */
+    unsigned long currentScanline;
+
+    /** file offset of the first chunk */
+    uint64_t dataOffset;
+
+    /** chunk offsets relative to dataOffset (numChunks+1 entries) */
+    vector<uint64_t> chunkOffsets;
+
+    /** index of the first chunk currently in the cache (or -1) */
+    long cachedChunk;
+
+    /** number of chunks currently in the cache */
+    unsigned long cachedChunks;
+
+    /** decompressed data of the cached chunks */
+    vector<char> chunkBuffer;
+
+    /** compressed data read from the file */
+    vector<char> compressedBuffer;
+  };
+
+
+  /** \class ChunkCompressionOption ChunkedMDAFile.hh
+      parser for chunk compression methods */
+  class ChunkCompressionOption: public CommandlineOption {
+
+  public:
+
+    /** constructor from reference to ChunkCompression object */
+    ChunkCompressionOption( ChunkCompression &c,
+			    const char *msg= "\tchunk compression "
+			    "(none, zstd, or lz4)\n",
+			    const char *longOpt= "--chunk-compression",
+			    const char *shortOpt= NULL )
+      : CommandlineOption( msg, longOpt, shortOpt ), compression( c )
+    {}
+
+    /** the actual parsing function */
+    virtual bool parse( int &index, int argc, char *argv[] );
+
+    /** output usage string */
+    virtual void usage( ostream &os= cerr );
+
+  protected:
+
+    /** reference to the ChunkCompression object */
+    ChunkCompression &compression;
+  };
+
+
+} /* namespace */
+
+
+
+#endif /* BASE_CHUNKEDMDAFILE_H */
+
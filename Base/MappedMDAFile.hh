@@ -0,0 +1,189 @@
+// ==========================================================================
+// $Id:$
+// read-only, memory-mapped access to uncompressed MDA files
+// ==========================================================================
+// License: Internal use at UBC only! External use is a copyright violation!
+// ==========================================================================
+// (C)opyright:
+//
+// 2007-, UBC
+//
+// Creator: heidrich (Wolfgang Heidrich)
+// Email:   heidrich@cs.ubc.ca
+// ==========================================================================
+
+#ifndef BASE_MAPPEDMDAFILE_H
+#define BASE_MAPPEDMDAFILE_H
+
+/*! \file  MappedMDAFile.hh
+    \brief read-only, memory-mapped access to uncompressed MDA files
+ */
+
+#if defined(_WIN32) || defined(_WIN64)
+// this header file must be included before all the others
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Types.hh"
+#include "BitsAndBytes.hh"
+#include "CoordinateVector.hh"
+
+namespace MDA {
+
+  using namespace std;
+
+  /** \class MappedMDAFile MappedMDAFile.hh
+      read-only, memory-mapped access to uncompressed MDA files.
+
+      Scanlines and channels are returned as pointers directly into
+      the mapping, so no data is copied, and only the pages that are
+      actually touched are ever loaded from disk. This only works for
+      regular files in native byte order; open() fails for anything
+      else (pipes, compressed files, foreign byte order), in which
+      case the caller should fall back to an MDAReader.
+  */
+  class MappedMDAFile {
+
+  public:
+
+    /** expected access pattern (passed on to the OS as a hint) */
+    enum AccessPattern
+    {
+      NormalAccess,
+      SequentialAccess,
+      RandomAccess,
+      WillNeedAccess
+    };
+
+    /** default constructor */
+    MappedMDAFile();
+
+    /** destructor (unmaps the file if required) */
+    ~MappedMDAFile();
+
+    /** parse the header and map the data portion of a file */
+    bool open( const char *fileName );
+
+    /** unmap the file */
+    void close();
+
+    /** whether a file is currently mapped */
+    inline bool isOpen() const
+    {
+      return data!= NULL;
+    }
+
+    /** give the OS a hint on how a range of scanlines will be
+	accessed (numScanlines==0 means all remaining scanlines) */
+    void advise( AccessPattern pattern, unsigned long firstScanline= 0,
+		 unsigned long numScanlines= 0 );
+
+    /** data type */
+    inline DataType getType() const
+    {
+      return type;
+    }
+
+    /** array dimensions */
+    inline const CoordinateVector &getDim() const
+    {
+      return dim;
+    }
+
+    /** number of channels */
+    inline unsigned getNumChannels() const
+    {
+      return numChannels;
+    }
+
+    /** total number of scanlines */
+    inline unsigned long getNumScanlines() const
+    {
+      return numScanlines;
+    }
+
+    /** size of one scanline in bytes */
+    inline unsigned long getScanlineSize() const
+    {
+      return scanlineSize;
+    }
+
+    /** pointer to the beginning of the array data */
+    inline const void *getData() const
+    {
+      return data;
+    }
+
+    /** pointer to a specific scanline */
+    inline const void *getScanline( unsigned long i ) const
+    {
+      return data+(size_t)i*scanlineSize;
+    }
+
+    /** pointer to the first element of a channel. Channels are
+	interleaved in MDA files, so consecutive elements of the
+	channel are getChannelStride() bytes apart */
+    inline const void *getChannel( unsigned ch ) const
+    {
+      return data+ch*dataTypeSizes[type];
+    }
+
+    /** byte increment between consecutive elements of one channel */
+    inline unsigned long getChannelStride() const
+    {
+      return numChannels*dataTypeSizes[type];
+    }
+
+  protected:
+
+    /** read the header of the MDA file, and determine data offset */
+    bool readHeader( const char *fileName );
+
+    /** data type of the file */
+    DataType type;
+
+    /** array dimensions */
+    CoordinateVector dim;
+
+    /** number of channels */
+    unsigned numChannels;
+
+    /** number of scanlines */
+    unsigned long numScanlines;
+
+    /** size of one scanline in bytes */
+    unsigned long scanlineSize;
+
+    /** start of the array data within the mapping */
+    const char *data;
+
+    /** start of the mapping (page aligned) */
+    void *mapping;
+
+    /** length of the mapping */
+    size_t mappingSize;
+
+    /** offset of the array data within the file (64 bit, since
+	unsigned long only has 32 bits on Win64) */
+    uint64_t dataOffset;
+
+#if defined(_WIN32) || defined(_WIN64)
+    /** file handle */
+    HANDLE fileHandle;
+
+    /** handle of the file mapping object */
+    HANDLE mappingHandle;
+#endif
+  };
+
+
+} /* namespace */
+
+
+
+#endif /* BASE_MAPPEDMDAFILE_H */
+
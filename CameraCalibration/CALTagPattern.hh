@@ -38,6 +38,7 @@
 
 #include "MDA/GeometricTransform/GeometricTransform.hh"
 #include "MDA/Filters/ConnectedComponentProperties.hh"
+#include "MDA/Filters/AdaptiveThreshold.hh"
 #include "MDA/DataAnalysis/SampleVector.hh"
 #include "MDA/DataAnalysis/lloydQuadFinder.hh"
 #include "MDA/DataAnalysis/ClusterModifier.hh"
@@ -204,7 +205,8 @@ namespace MDA {
         respect to a set of matched points as needed by RANSAC. */
     void homogdist2d(const SampleVector *pointsIn, const SampleVector *pointsOut, Matrix* H, double t, vector<unsigned long>* inliers );
 
-    /** fits 2D homography using the RANSAC algorithm. Returns true if successful*/
+    /** fits 2D homography using the RANSAC algorithm (see HomographyRANSAC; the sample
+        size s has to be 4, and feedback is ignored). Returns true if successful*/
     bool ransacFitHomography(const SampleVector *pointsIn, const SampleVector *pointsOut, Matrix* H, 
                              vector<unsigned long>* inliers, double t, unsigned long s = 4, unsigned long feedback = 0,
                              unsigned long maxDataTrials = 100, unsigned long maxTrials = 1000 );
@@ -0,0 +1,270 @@
+// ==========================================================================
+// $Id:$
+// robust estimation of 2D homographies with (parallel) RANSAC
+// ==========================================================================
+// License: Internal use at UBC only! External use is a copyright violation!
+// ==========================================================================
+// (C)opyright:
+//
+// 2007-, UBC
+//
+// Creator: heidrich (Wolfgang Heidrich)
+// Email:   heidrich@cs.ubc.ca
+// ==========================================================================
+
+#ifndef CAMERACALIB_HOMOGRAPHYRANSAC_H
+#define CAMERACALIB_HOMOGRAPHYRANSAC_H
+
+/*! \file  HomographyRANSAC.hh
+    \brief robust estimation of 2D homographies with (parallel) RANSAC
+ */
+
+#ifdef _WIN32
+// this header file must be included before all the others
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+#include <vector>
+
+#include "MDA/Threading/SMPJob.hh"
+
+namespace MDA {
+
+  using namespace std;
+
+  class HomographyRANSACJob;
+
+  /** \class HomographyRANSAC HomographyRANSAC.hh
+      robust estimation of a 2D homography from a set of point
+      correspondences with RANSAC.
+
+      Points are passed as flat arrays of (x,y) pairs, and homographies
+      as 3x3 matrices in row major order, mapping the input points to
+      the output points. Both point sets are normalized (centroid at the
+      origin, mean distance sqrt(2)) before the estimation, and the
+      inlier threshold refers to the symmetric transfer error
+      (squared distances in both images) in these normalized
+      coordinates.
+
+      The trials are distributed over multiple threads in rounds of a
+      few trials per thread. Every trial fits a model to four points
+      in closed form on the stack, and counts the inliers with SSE2
+      (four correspondences at a time). The number of trials is
+      adapted to the inlier ratio of the best model found so far.
+      Optionally, every new best model is refined by iterated least
+      squares fits to its inliers (LO-RANSAC), and the samples can be
+      drawn from a progressively growing set of the first points
+      (PROSAC) if the correspondences are sorted by decreasing
+      quality.
+  */
+  class HomographyRANSAC {
+
+  public:
+
+    /** constructor */
+    HomographyRANSAC( double _threshold= 0.01, double _confidence= 0.99,
+		      unsigned long _maxTrials= 1000 );
+
+    /** set the inlier threshold (squared, in normalized coordinates) */
+    inline void setThreshold( double t )
+    {
+      threshold= t;
+    }
+
+    /** set the desired probability of drawing at least one sample
+	that is free of outliers */
+    inline void setConfidence( double p )
+    {
+      confidence= p;
+    }
+
+    /** set the maximum number of trials */
+    inline void setMaxTrials( unsigned long n )
+    {
+      maxTrials= n;
+    }
+
+    /** set the maximum number of attempts to draw a non-degenerate
+	sample */
+    inline void setMaxDataTrials( unsigned long n )
+    {
+      maxDataTrials= n;
+    }
+
+    /** enable/disable the local optimization of new best models */
+    inline void setLocalOptimization( bool lo )
+    {
+      localOptimization= lo;
+    }
+
+    /** enable/disable progressive sampling (the correspondences
+	have to be sorted by decreasing quality) */
+    inline void setProgressive( bool p )
+    {
+      progressive= p;
+    }
+
+    /** set the seed of the random number generators */
+    inline void setSeed( unsigned s )
+    {
+      seed= s;
+    }
+
+    /** number of trials in the last fit */
+    inline unsigned long getNumTrials() const
+    {
+      return numTrials;
+    }
+
+    /** fit a homography to numPoints correspondences. Returns false if
+	no model with the desired confidence was found within the
+	maximum number of trials. The indices of the inliers are
+	stored in the inliers vector, if provided */
+    bool fit( const double *in, const double *out, unsigned long numPoints,
+	      double H[9], vector<unsigned long> *inliers= NULL );
+
+    /** exact homography from four correspondences (returns false for
+	degenerate configurations) */
+    static bool fitMinimal( const double in[8], const double out[8],
+			    double H[9] );
+
+    /** least squares (DLT) homography from the correspondences with
+	the given indices (all correspondences if indices is NULL) */
+    static bool fitLeastSquares( const double *in, const double *out,
+				 const unsigned long *indices, unsigned long n,
+				 double H[9] );
+
+    /** whether any three of four points are (almost) collinear */
+    static bool isDegenerate( const double points[8],
+			      double threshold= 0.01 );
+
+    /** normalize n points so that their centroid is at the origin, and
+	their mean distance from it is sqrt(2); the transformation is
+	stored in transform */
+    static void normalizePoints( const double *points,
+				 const unsigned long *indices, unsigned long n,
+				 double *normalized, double transform[9] );
+
+  protected:
+
+    friend class HomographyRANSACJob;
+
+    /** run up to count trials, starting from trial number first with
+	the given stride, and stopping early once the desired
+	confidence is reached. The best model is stored in H, and its
+	number of inliers is returned */
+    unsigned long runTrials( unsigned long first, unsigned long stride,
+			     unsigned long count, unsigned &rng,
+			     double H[9], vector<unsigned long> &indices,
+			     unsigned long &executed, bool &failed ) const;
+
+    /** refine a model by iterated least squares fits to its inliers */
+    unsigned long optimize( double H[9], unsigned long score,
+			    vector<unsigned long> &indices ) const;
+
+    /** draw a non-degenerate sample for the given trial number */
+    bool drawSample( unsigned long trial, unsigned &rng,
+		     double in[8], double out[8] ) const;
+
+    /** count the inliers of a model in normalized coordinates, and
+	store their indices if requested */
+    unsigned long countInliers( const double H[9],
+				unsigned long *indices= NULL ) const;
+
+    /** number of trials required for the given number of inliers */
+    unsigned long requiredTrials( unsigned long numInliers ) const;
+
+    /** inlier threshold */
+    double threshold;
+
+    /** desired confidence */
+    double confidence;
+
+    /** maximum number of trials */
+    unsigned long maxTrials;
+
+    /** maximum number of attempts to draw a non-degenerate sample */
+    unsigned long maxDataTrials;
+
+    /** whether new best models are locally optimized */
+    bool localOptimization;
+
+    /** whether samples are drawn progressively */
+    bool progressive;
+
+    /** random seed */
+    unsigned seed;
+
+    /** number of trials in the last fit */
+    unsigned long numTrials;
+
+    /** number of correspondences */
+    unsigned long numPoints;
+
+    /** normalized correspondences as (x,y) pairs */
+    vector<double> normIn, normOut;
+
+    /** normalized correspondences as planes of floats, padded with NaNs
+	(which are never inliers) to a multiple of four */
+    vector<float> inX, inY, outX, outY;
+
+    /** for progressive sampling: the trial number from which on the
+	sampling set has n points */
+    vector<unsigned long> growth;
+
+    /** best model so far, and its number of inliers */
+    double bestH[9];
+    unsigned long bestScore;
+
+    /** set if no non-degenerate sample could be drawn */
+    bool failed;
+  };
+
+
+  /** \class HomographyRANSACJob HomographyRANSAC.hh
+      multithreading job for a number of RANSAC trials; the best model
+      of all jobs is selected in the reduction */
+  class HomographyRANSACJob: public SMPJob {
+
+  public:
+
+    /** constructor */
+    HomographyRANSACJob( HomographyRANSAC *_ransac,
+			 unsigned long _first, unsigned long _stride,
+			 unsigned long _count, unsigned _rng );
+
+    /** run the trials */
+    virtual void execute( int jobID );
+
+    /** keep the better of this model and the best so far */
+    virtual void reduce( int jobID );
+
+  protected:
+
+    /** the estimator */
+    HomographyRANSAC *ransac;
+
+    /** first trial, stride between trials, and number of trials */
+    unsigned long first, stride, count;
+
+    /** random number generator state */
+    unsigned rng;
+
+    /** best model of this job, and its number of inliers */
+    double H[9];
+    unsigned long score;
+
+    /** number of trials actually executed */
+    unsigned long executed;
+
+    /** set if no non-degenerate sample could be drawn */
+    bool failed;
+
+    /** inlier indices (scratch space) */
+    vector<unsigned long> indices;
+  };
+
+} /* namespace */
+
+#endif /* CAMERACALIB_HOMOGRAPHYRANSAC_H */
@@ -25,12 +25,26 @@
 #include <windows.h>
 #endif
 
+#include "MDA/Array/Array.hh"
+#include "MDA/LinearAlgebra/LinAlg.hh"
+#include "MDA/Resampling/Resampler.hh"
+#include "Camera.hh"
+
 namespace MDA {
   
   /** compute the 3x3 rectifying transformations for a pair of cameras */
   void getRectifyTransforms( const Camera C1, const Camera C2, Matrix& Rect1, Matrix& Rect2 );
   
-  // more functionality to come (for actually performing rectification using the transforms)
+  /** rectify all channels of a 2D image with one of the transformations
+   *  from getRectifyTransforms (which map original pixel positions to
+   *  rectified ones). The image is resampled in a single pass with a
+   *  projective warp. If dstArray has no dimensions yet, it gets the
+   *  dimensions of srcArray. The resampler is owned by the function;
+   *  if it is NULL, cubic interpolation with a black background is
+   *  used */
+  template<class T>
+  bool rectifyImage( Array<T> &srcArray, Array<T> &dstArray, const Matrix &rect,
+		     Resampler<T> *resampler= NULL );
 
 } /* namespace */
 
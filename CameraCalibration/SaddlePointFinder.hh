@@ -31,13 +31,25 @@
 #include "MDA/DataAnalysis/SampleVector.hh"
 #include "MDA/Filters/Filter.hh"
 #include "MDA/Filters/Linear1DFilter.hh"
+#include "MDA/Threading/SMPJob.hh"
 
 namespace MDA {
 
   using namespace std;
 
+  // forward declaration
+  template <class T> class SaddlePointJob;
+
   /** \class SaddlePointFinder SaddlePointFinder.hh
-      A 2D saddlepoint finder. Based on the matlab cameracalibration toolbox file cornerfinder_saddle_point.m */
+      A 2D saddlepoint finder. Based on the matlab cameracalibration toolbox file cornerfinder_saddle_point.m
+
+      The guesses are refined independently of each other, in parallel
+      jobs. Every refinement works on fixed-size scratch buffers for the
+      interpolated window (on the stack for the usual window sizes),
+      extracts the bilinearly interpolated window with SSE2, and fuses
+      the gradients into the accumulation of the structure tensor. The
+      weights of the final quadratic fit only depend on the mask, and
+      are precomputed in the constructor. */
   template<class T> 
   class SaddlePointFinder {
 
@@ -56,6 +68,12 @@ namespace MDA {
 
   protected:
 
+    /** refines a single guess in place, using a scratch buffer of
+	2*(2*wintx+5)*(2*winty+5) elements. Returns false (and restores
+	the original guess) if the point diverged */
+    bool refineSaddle( const T *srcData, double &guessX, double &guessY,
+		       T *scratch );
+
     /// image and its dimensions the saddlepointfinder works on
     Array<T> *image;
     CoordinateVector imgDim;
@@ -71,6 +89,49 @@ namespace MDA {
     /// maximum number of iterations
     int MaxIter;
 
+    /// weights of the window samples in the six coefficients of the
+    /// final quadratic fit (relative to the window center)
+    double* fitWeights;
+
+    /// SaddlePointJob refines the guesses
+    friend class SaddlePointJob<T>;
+  };
+
+
+  /** \class SaddlePointJob SaddlePointFinder.hh
+      multithreading job for refining a range of guesses */
+  template<class T>
+  class SaddlePointJob: public SMPJob {
+
+  public:
+
+    /** constructor (points holds the guesses as (x,y) pairs) */
+    inline SaddlePointJob( SaddlePointFinder<T> *_finder, const T *_srcData,
+			   double *_points, char *_diverged,
+			   unsigned long _first, unsigned long _last )
+      : SMPJob( (double)(_last-_first) * (_finder->MaxIter+1) *
+		(2*_finder->wintx+5) * (2*_finder->winty+5) * 20 ),
+	finder( _finder ), srcData( _srcData ), points( _points ),
+	diverged( _diverged ), first( _first ), last( _last )
+    {}
+
+    /** refine the guesses */
+    virtual void execute( int jobID );
+
+  protected:
+
+    /** the saddle point finder */
+    SaddlePointFinder<T> *finder;
+
+    /** image data */
+    const T *srcData;
+
+    /** guesses as (x,y) pairs, and divergence flags */
+    double *points;
+    char *diverged;
+
+    /** range of guesses */
+    unsigned long first, last;
   };
 
 
@@ -89,6 +89,13 @@ namespace MDA {
       Lab[2]= 200.0 * (fY - fZ);
     }
     
+    /** convert n pixels from L*a*b* to XYZ (see ColorSpace) */
+    virtual void convertToXYZ( const float *in, float *out, size_t n,
+			       size_t inStride= 0, size_t outStride= 0 ) const;
+    
+    /** convert n pixels from XYZ to L*a*b* (see ColorSpace) */
+    virtual void convertFromXYZ( const float *in, float *out, size_t n,
+				 size_t inStride= 0, size_t outStride= 0 ) const;
     
   protected:
 
@@ -104,10 +111,10 @@ namespace MDA {
     /** inverse of compressive function */
     inline double fInv( double val ) const
     {
-      if( val> 27.0/216.0 )
-	return pow( val, 3.0 );
+      if( val> 6.0/29.0 )
+	return val*val*val;
       else
-	return (val - 116.0/16.0) * 27.0*116.0/24389.0;
+	return (val - 16.0/116.0) * 27.0*116.0/24389.0;
     }
     
     /** Yu'v' representation of the whitepoint */
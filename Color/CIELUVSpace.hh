@@ -102,6 +102,14 @@ namespace MDA {
       Luv[2]= 13.0 * Luv[0] * (Yuv[2] - wpYuv[2]);
     }    
     
+    /** convert n pixels from L*u*v* to XYZ (see ColorSpace) */
+    virtual void convertToXYZ( const float *in, float *out, size_t n,
+			       size_t inStride= 0, size_t outStride= 0 ) const;
+    
+    /** convert n pixels from XYZ to L*u*v* (see ColorSpace) */
+    virtual void convertFromXYZ( const float *in, float *out, size_t n,
+				 size_t inStride= 0, size_t outStride= 0 ) const;
+    
   protected:
   
     /** Yuv color space object */
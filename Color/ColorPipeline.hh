@@ -0,0 +1,209 @@
+// ==========================================================================
+// $Id:$
+// a chain of color transformations, optionally baked into lookup tables
+// ==========================================================================
+// License: Internal use at UBC only! External use is a copyright violation!
+// ==========================================================================
+// (C)opyright:
+//
+// 2007-, UBC
+//
+// Creator: heidrich (Wolfgang Heidrich)
+// Email:   heidrich@cs.ubc.ca
+// ==========================================================================
+
+#ifndef COLOR_COLORPIPELINE_H
+#define COLOR_COLORPIPELINE_H
+
+/*! \file  ColorPipeline.hh
+    \brief a chain of color transformations, optionally baked into
+    lookup tables
+ */
+
+#ifdef _WIN32
+// this header file must be included before all the others
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+#include <vector>
+
+#include "MDA/Base/Types.hh"
+#include "ColorSpace.hh"
+#include "ToneCurve.hh"
+#include "WhiteBalance.hh"
+
+namespace MDA {
+
+  using namespace std;
+
+  /** \class ColorPipeline ColorPipeline.hh
+      a chain of color transformations (tone curves, conversions
+      to/from XYZ, white balancing, and 1D lookup tables) that is
+      applied as a single transform.
+
+      The pipeline can be evaluated directly in single precision, or,
+      for 8 and 16 bit input, be baked into lookup tables: the leading
+      per-channel stages become 1D tables indexed directly by the input
+      values, the stages that mix channels are sampled on a 3D grid
+      that is interpolated tetrahedrally, and the trailing per-channel
+      stages become 1D tables on the grid output. Pipelines without
+      stages that mix channels are baked into 1D tables only.
+  */
+  class ColorPipeline {
+
+  public:
+
+    /** constructor for the given number of input channels */
+    ColorPipeline( unsigned _inDimension= 3 );
+
+    /** destructor (deletes all stages) */
+    ~ColorPipeline();
+
+    /** append a tone curve that maps to linear (toLinear= true) or
+	from linear, applied to every channel (the pipeline takes
+	ownership of the curve) */
+    void addToneCurve( ToneCurve *curve, bool toLinear );
+
+    /** append a conversion from the given space to XYZ (the pipeline
+	takes ownership of the space) */
+    bool addToXYZ( ColorSpace *space );
+
+    /** append a conversion from XYZ to the given space (the pipeline
+	takes ownership of the space) */
+    bool addFromXYZ( ColorSpace *space );
+
+    /** append a white balance of 3-channel colors (the pipeline takes
+	ownership of the white balance) */
+    bool addWhiteBalance( WhiteBalance *balance );
+
+    /** append a 1D lookup table with lutSize entries of numChannels
+	values over the input range [0..1] (linearly interpolated).
+	A single input channel is mapped to all table channels, otherwise
+	channel k is mapped through table channel k */
+    bool addLUT( const float *lut, unsigned lutSize, unsigned numChannels );
+
+    /** number of input channels */
+    inline unsigned getInDimension() const
+    {
+      return inDimension;
+    }
+
+    /** number of output channels */
+    inline unsigned getOutDimension() const
+    {
+      return stages.size()> 0 ? stages.back().outDimension : inDimension;
+    }
+
+    /** apply the pipeline to n pixels (strides in floats, 0 for
+	densely packed pixels) */
+    void apply( const float *in, float *out, size_t n,
+		size_t inStride= 0, size_t outStride= 0 ) const;
+
+    /** apply the pipeline to n pixels of the given type, using the
+	baked tables if they were built for this type */
+    void apply( const void *in, DataType inType, float *out, size_t n,
+		size_t inStride= 0, size_t outStride= 0 ) const;
+
+    /** bake the pipeline into lookup tables for input of the given type
+	(UByte or UShort), with gridSize samples per axis of the 3D table;
+	returns false if the pipeline cannot be baked */
+    bool bake( DataType inType, unsigned gridSize= 33 );
+
+    /** whether the pipeline has been baked for the given input type */
+    inline bool isBaked( DataType inType ) const
+    {
+      return bakedType== inType;
+    }
+
+  protected:
+
+    /** the kinds of stages */
+    enum StageType {
+      ToLinearStage,
+      FromLinearStage,
+      ToXYZStage,
+      FromXYZStage,
+      WhiteBalanceStage,
+      LUTStage
+    };
+
+    /** one stage of the pipeline */
+    struct Stage {
+      /** what the stage does */
+      StageType type;
+      /** number of input and output channels */
+      unsigned inDimension, outDimension;
+      /** tone curve for ToLinearStage and FromLinearStage */
+      ToneCurve *curve;
+      /** color space for ToXYZStage and FromXYZStage */
+      ColorSpace *space;
+      /** white balance for WhiteBalanceStage */
+      WhiteBalance *balance;
+      /** table for LUTStage (lutSize entries of outDimension values) */
+      vector<float> lut;
+      unsigned lutSize;
+    };
+
+    /** append a stage, and invalidate the baked tables */
+    void addStage( const Stage &stage );
+
+    /** whether a stage treats all channels independently */
+    static bool isPerChannel( const Stage &stage );
+
+    /** apply stages [first..last) in place to n pixels with the given
+	stride (which has to be at least the maximum dimension of these
+	stages) */
+    void applyStages( unsigned first, unsigned last,
+		      float *buf, size_t n, size_t stride ) const;
+
+    /** apply the baked tables to n pixels of integer type I */
+    template<class I>
+    void applyBaked( const I *in, float *out, size_t n,
+		     size_t inStride, size_t outStride ) const;
+
+    /** number of input channels */
+    unsigned inDimension;
+
+    /** the stages in order of application */
+    vector<Stage> stages;
+
+    /** maximum number of channels of any stage */
+    unsigned maxDimension;
+
+    /** input type of the baked tables (UndefinedType if not baked) */
+    DataType bakedType;
+
+    /** stages [0..coreStart) are in the input tables, stages
+	[coreStart..coreEnd) in the 3D table, and the remaining ones in
+	the output tables */
+    unsigned coreStart, coreEnd;
+
+    /** input tables: one entry per input value for each channel */
+    vector<float> inTables;
+
+    /** number of entries per input table */
+    unsigned long numInValues;
+
+    /** 3D table domain (lower end and samples per unit for each axis) */
+    float gridMin[3], gridScale[3];
+
+    /** samples per axis of the 3D table */
+    unsigned gridSize;
+
+    /** the 3D table (x fastest, coreOut values per sample) */
+    vector<float> grid;
+
+    /** output tables: a fixed number of entries for each channel */
+    vector<float> outTables;
+
+    /** output table domain (lower end and samples per unit for each
+	channel) */
+    vector<float> outMin, outScale;
+  };
+
+
+} /* namespace */
+
+#endif /* COLOR_COLORPIPELINE_H */
+
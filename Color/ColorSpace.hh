@@ -25,6 +25,8 @@
 #include <windows.h>
 #endif
 
+#include <stddef.h>
+
 #include "MDA/LinearAlgebra/Vector.hh"
 
 namespace MDA {
@@ -33,6 +35,12 @@ namespace MDA {
    *   abstract base class for all color spaces
    * 
    *   all color spaces need to be able to convert to/from XYZ  
+   *
+   *   Besides the per-pixel Vector interface, there is a batched
+   *   interface for converting whole scanlines of single precision
+   *   data. The default implementation of the batched interface goes
+   *   through the Vector interface, but subclasses override it with
+   *   versions that do not allocate any memory.
    */
   
   class ColorSpace {
@@ -51,6 +59,35 @@ namespace MDA {
     /** convert from XYZ to this space */
     virtual void fromXYZ( const Vector &XYZ, Vector &tristimulus ) const= 0;
     
+    /** convert n pixels from this space to XYZ; the strides are the
+	distances between consecutive pixels in floats (0 for densely
+	packed pixels). The conversion may be done in place if both
+	strides are the same */
+    virtual void convertToXYZ( const float *in, float *out, size_t n,
+			       size_t inStride= 0, size_t outStride= 0 ) const;
+    
+    /** convert n pixels from XYZ to this space (see convertToXYZ) */
+    virtual void convertFromXYZ( const float *in, float *out, size_t n,
+				 size_t inStride= 0, size_t outStride= 0 ) const;
+    
+  protected:
+    
+    /** fast cube root of a positive value, accurate to single precision
+	(used instead of pow() by the batched conversions) */
+    static inline float cubeRoot( float val )
+    {
+      // initial guess from halving the exponent in the float
+      // representation, followed by two Halley iterations
+      union { float f; unsigned int i; } bits;
+      bits.f= val;
+      bits.i= bits.i/3 + 709921077u;
+      float r= bits.f;
+      float r3= r*r*r;
+      r= r * (r3 + val + val) / (r3 + r3 + val);
+      r3= r*r*r;
+      return r * (r3 + val + val) / (r3 + r3 + val);
+    }
+    
   };
 
 
@@ -47,6 +47,11 @@ namespace MDA {
     /** create a new ColorSpace object using the current parameters */
     ColorSpace *makeColorSpace();
     
+    /** create a new ColorSpace object for a named space (a standard
+	linear tristimulus space, or one of the directly supported ones),
+	without a tone curve */
+    static ColorSpace *makeColorSpace( const char *name );
+    
   protected:
     
     /** list of standard linear tristimulus spaces */
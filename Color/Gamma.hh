@@ -45,6 +45,9 @@ namespace MDA {
       gain\cdot I_{in}^{1/gamma}+bias&;\mathrm{else}
       \end{array}\right.
       \f]
+      
+      The batched float conversions replace pow() with a piecewise
+      polynomial approximation (relative error below 1e-6).
   */
   class Gamma: public ToneCurve {
 
@@ -76,6 +79,18 @@ namespace MDA {
     /** conversion from non-linear to linear space */
     virtual double toLinear( double nonlinearVal );
     
+    // the vector and typed versions from the base class
+    using ToneCurve::fromLinear;
+    using ToneCurve::toLinear;
+    
+    /** conversion of n floats from linear to non-linear space */
+    virtual void fromLinear( const float *linear, float *nonlinear, size_t n,
+			     size_t inStride= 1, size_t outStride= 1 );
+    
+    /** conversion of n floats from non-linear to linear space */
+    virtual void toLinear( const float *nonlinear, float *linear, size_t n,
+			   size_t inStride= 1, size_t outStride= 1 );
+    
     /** return a list of the names of known standard gammas
 	(the strings are apppended to the end of the existing list) */
     static void getStandardNames( list<const char *> &names );
@@ -105,6 +120,47 @@ namespace MDA {
     
     /** whether or not to clamp to the range 0..1 */
     bool clamp;
+    
+    /** \class FastPower Gamma.hh
+	approximation of x^p for positive floats: a table of 2^(e*p)
+	for every binary exponent e, times a degree 4 polynomial of
+	the mantissa on each quarter of [1..2) */
+    class FastPower {
+      
+    public:
+      
+      /** fit the approximation for exponent p */
+      void init( double p );
+      
+      /** evaluate x^p for x> 0 */
+      inline float eval( float x ) const
+      {
+	union { float f; unsigned int i; } bits;
+	bits.f= x;
+	unsigned exponent= bits.i >> 23;
+	unsigned piece= (bits.i >> 21) & 3;
+	bits.i= (bits.i & 0x007fffff) | 0x3f800000;
+	float t= bits.f - (1.125f + 0.25f*piece);
+	const float *c= coeffs[piece];
+	return expScale[exponent] *
+	  (c[0] + t*(c[1] + t*(c[2] + t*(c[3] + t*c[4]))));
+      }
+      
+    protected:
+      
+      /** 2^(e*p) for each biased exponent e */
+      float expScale[256];
+      
+      /** polynomial coefficients for each quarter of the mantissa
+	  range, relative to the center of the quarter */
+      float coeffs[4][5];
+    };
+    
+    /** approximation for the non-linear part of fromLinear */
+    FastPower encodePower;
+    
+    /** approximation for the non-linear part of toLinear */
+    FastPower decodePower;
   };
 
   
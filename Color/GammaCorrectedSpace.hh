@@ -76,6 +76,14 @@ namespace MDA {
     
     /** convert from XYZ to this space */
     virtual void fromXYZ( const Vector &XYZ, Vector &tristimulus ) const;
+    
+    /** convert n pixels from this space to XYZ (see ColorSpace) */
+    virtual void convertToXYZ( const float *in, float *out, size_t n,
+			       size_t inStride= 0, size_t outStride= 0 ) const;
+    
+    /** convert n pixels from XYZ to this space (see ColorSpace) */
+    virtual void convertFromXYZ( const float *in, float *out, size_t n,
+				 size_t inStride= 0, size_t outStride= 0 ) const;
 
   protected:
 
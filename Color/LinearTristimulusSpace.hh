@@ -49,12 +49,16 @@ namespace MDA {
     inline LinearTristimulusSpace( Matrix &fromXYZ,
 				   Matrix &toXYZ )
       : toXYZMatrix( toXYZ ), fromXYZMatrix( fromXYZ )
-    {}
+    {
+      updateFloatMatrices();
+    }
     
     /** copy constuctor */
     inline LinearTristimulusSpace( const LinearTristimulusSpace &other )
       : toXYZMatrix( other.toXYZMatrix ), fromXYZMatrix( other.fromXYZMatrix )
-    {}
+    {
+      updateFloatMatrices();
+    }
     
     /** report dimensionality of space */
     inline virtual unsigned getDimension() const
@@ -68,18 +72,34 @@ namespace MDA {
     /** convert from XYZ to this space */
     virtual void fromXYZ( const Vector &XYZ, Vector &tristimulus ) const;
     
+    /** convert n pixels from this space to XYZ (see ColorSpace) */
+    virtual void convertToXYZ( const float *in, float *out, size_t n,
+			       size_t inStride= 0, size_t outStride= 0 ) const;
+    
+    /** convert n pixels from XYZ to this space (see ColorSpace) */
+    virtual void convertFromXYZ( const float *in, float *out, size_t n,
+				 size_t inStride= 0, size_t outStride= 0 ) const;
+    
     /** return a list of the names of known standard spaces
 	(the strings are apppended to the end of the existing list)  */
     static void getStandardNames( list<const char *> &names );
     
   protected:
 
+    /** copy the matrices into the single precision versions */
+    void updateFloatMatrices();
+    
     /** matrix for conversion to XYZ */
     Matrix toXYZMatrix;
     
     /** matrix for conversion from XYZ */
     Matrix fromXYZMatrix;
 
+    /** single precision copies of the two matrices (row major) for the
+	batched conversions */
+    float toXYZFloat[9];
+    float fromXYZFloat[9];
+
   };
 
 
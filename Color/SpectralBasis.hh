@@ -30,6 +30,7 @@
 #include "MDA/LinearAlgebra/LinAlg.hh"
 #include "MDA/Array/Array.hh"
 #include "Spectrum.hh"
+#include "SpectralProjection.hh"
 
 
 namespace MDA {
@@ -45,7 +46,7 @@ namespace MDA {
 
     /** default constructor */
     inline SpectralBasis()
-      : dualInitialized( false ), dualBasis()
+      : dualInitialized( false ), dualBasis(), projectionsInitialized( false )
     {}
     
     /** constructor from Array channels (float version)
@@ -58,7 +59,7 @@ namespace MDA {
      */
     inline SpectralBasis( Array<double> &array, const ChannelList &channels,
 			  const IntRange &aRange, const IntRange &range )
-      : dualInitialized( false ), dualBasis()
+      : dualInitialized( false ), dualBasis(), projectionsInitialized( false )
     {
       unsigned numBasis= channels.vec.size();
       basis.reserve( numBasis );
@@ -76,7 +77,7 @@ namespace MDA {
      */
     inline SpectralBasis( Array<float> &array, const ChannelList &channels,
 			  const IntRange &aRange, const IntRange &range )
-      : dualInitialized( false ), dualBasis()
+      : dualInitialized( false ), dualBasis(), projectionsInitialized( false )
     {
       unsigned numBasis= channels.vec.size();
       basis.reserve( numBasis );
@@ -99,8 +100,25 @@ namespace MDA {
 	spectral basis as color filter) */
     virtual void dualToXYZ( const Vector &dualCoeff, Vector &XYZ );
     
+    /** XYZ coordinates of n linear combinations of the basis (strides
+	in floats, 0 for densely packed values) */
+    void toXYZ( const float *coeff, float *XYZ, size_t n,
+		size_t inStride= 0, size_t outStride= 0 );
+    
+    /** XYZ coordinates of n sets of dual coefficients (strides in
+	floats, 0 for densely packed values) */
+    void dualToXYZ( const float *dualCoeff, float *XYZ, size_t n,
+		    size_t inStride= 0, size_t outStride= 0 );
+    
   protected:
     
+    /** compute the dual basis matrix (if not done yet) */
+    void initDual();
+    
+    /** compute the XYZ coordinates of the basis and dual basis
+	spectra (if not done yet) */
+    void initProjections();
+    
     /** basis spectra */
     vector<Spectrum *> basis;
     
@@ -109,6 +127,12 @@ namespace MDA {
     
     /** coefficients of the dual basis, represented in matrix form */
     Matrix dualBasis;
+    
+    /** whether the projections have been computed already */
+    bool projectionsInitialized;
+    
+    /** XYZ coordinates of the basis spectra, and of the dual basis */
+    SpectralProjection primaryProjection, dualProjection;
   };
 
 
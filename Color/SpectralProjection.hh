@@ -0,0 +1,145 @@
+// ==========================================================================
+// $Id:$
+// projection of multiband pixels onto a set of weighting functions
+// ==========================================================================
+// License: Internal use at UBC only! External use is a copyright violation!
+// ==========================================================================
+// (C)opyright:
+//
+// 2007-, UBC
+//
+// Creator: heidrich (Wolfgang Heidrich)
+// Email:   heidrich@cs.ubc.ca
+// ==========================================================================
+
+#ifndef COLOR_SPECTRALPROJECTION_H
+#define COLOR_SPECTRALPROJECTION_H
+
+/*! \file  SpectralProjection.hh
+    \brief projection of multiband pixels onto a set of weighting functions
+ */
+
+#ifdef _WIN32
+// this header file must be included before all the others
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "MDA/Threading/SMPJob.hh"
+
+namespace MDA {
+
+  using namespace std;
+
+  /** \class SpectralProjection SpectralProjection.hh
+      projection of multiband pixels (e.g. spectral samples, or basis
+      coefficients) onto a set of weighting functions (e.g. color
+      matching functions), i.e. the multiplication of every pixel with
+      a numBands x numOutputs matrix.
+
+      Pixels are processed in pairs, and outputs in groups of four,
+      with an SSE2 kernel that accumulates four bands at a time in
+      single precision. Large blocks of pixels can be distributed
+      over multiple threads.
+  */
+  class SpectralProjection {
+
+  public:
+
+    /** constructor (all weights are initially zero) */
+    SpectralProjection( unsigned _numBands= 0, unsigned _numOutputs= 3 );
+
+    /** change the size (all weights are reset to zero) */
+    void resize( unsigned _numBands, unsigned _numOutputs );
+
+    /** number of input bands */
+    inline unsigned getNumBands() const
+    {
+      return numBands;
+    }
+
+    /** number of outputs */
+    inline unsigned getNumOutputs() const
+    {
+      return numOutputs;
+    }
+
+    /** weight of one band for one output */
+    inline double getWeight( unsigned band, unsigned output ) const
+    {
+      return weights[output*numBands + band];
+    }
+
+    /** set the weight of one band for one output */
+    inline void setWeight( unsigned band, unsigned output, double weight )
+    {
+      weights[output*numBands + band]= (float)weight;
+    }
+
+    /** project n pixels (strides in floats, 0 for densely packed
+	pixels) */
+    void apply( const float *in, float *out, size_t n,
+		size_t inStride= 0, size_t outStride= 0 ) const;
+
+    /** project n pixels with multiple threads */
+    void applyParallel( const float *in, float *out, size_t n,
+			size_t inStride= 0, size_t outStride= 0 ) const;
+
+  protected:
+
+    /** number of input bands */
+    unsigned numBands;
+
+    /** number of outputs */
+    unsigned numOutputs;
+
+    /** one row of numBands weights for every output, padded with zero
+	rows to a multiple of four outputs */
+    vector<float> weights;
+  };
+
+
+  /** \class SpectralProjectionJob SpectralProjection.hh
+      multithreading job for projecting a block of pixels */
+  class SpectralProjectionJob: public SMPJob {
+
+  public:
+
+    /** constructor */
+    inline SpectralProjectionJob( const SpectralProjection *_projection,
+				  const float *_in, float *_out, size_t _n,
+				  size_t _inStride, size_t _outStride )
+      : projection( _projection ), in( _in ), out( _out ), n( _n ),
+	inStride( _inStride ), outStride( _outStride )
+    {}
+
+    /** project the pixels */
+    virtual void execute( int threadID );
+
+  protected:
+
+    /** the projection */
+    const SpectralProjection *projection;
+
+    /** input pixels */
+    const float *in;
+
+    /** output pixels */
+    float *out;
+
+    /** number of pixels */
+    size_t n;
+
+    /** pixel strides */
+    size_t inStride, outStride;
+  };
+
+
+} /* namespace */
+
+#endif /* COLOR_SPECTRALPROJECTION_H */
+
@@ -26,13 +26,27 @@
 #endif
 
 
+#include <stddef.h>
+
+#include <vector>
+
 #include "MDA/Base/Errors.hh"
+#include "MDA/Base/Types.hh"
 #include "MDA/LinearAlgebra/Vector.hh"
 
 namespace MDA {
 
+  using namespace std;
+  
   /** \class ToneCurve ToneCurve.hh
-      Baseclass for tone curves */
+      Baseclass for tone curves
+      
+      Besides the scalar and vector conversions, tone curves can be
+      applied to whole scanlines of any data type. For UByte and
+      UShort data, all possible results are tabulated on first use,
+      so that the curve itself is only evaluated 256 or 65536 times.
+      Subclasses have to call invalidateTables() whenever the curve
+      changes. */
   
   class ToneCurve {
 
@@ -55,6 +69,46 @@ namespace MDA {
 	(default implementation uses identical curves for all channels) */
     virtual void toLinear( const Vector &nonlinear, Vector &linear );
     
+    /** conversion of n scalars from linear to non-linear space; the
+	strides are the distances between consecutive values (in place
+	if both strides are the same, default implementation calls the
+	scalar conversion for every value) */
+    virtual void fromLinear( const float *linear, float *nonlinear, size_t n,
+			     size_t inStride= 1, size_t outStride= 1 );
+    
+    /** conversion of n scalars from non-linear to linear space (see
+	above) */
+    virtual void toLinear( const float *nonlinear, float *linear, size_t n,
+			   size_t inStride= 1, size_t outStride= 1 );
+    
+    /** conversion of n values of the given type from linear to
+	non-linear space (values are normalized as in typeConvert, and
+	the strides are in values of that type) */
+    void fromLinear( const void *linear, DataType type, float *nonlinear,
+		     size_t n, size_t inStride= 1, size_t outStride= 1 );
+    
+    /** conversion of n values of the given type from non-linear to
+	linear space (see above) */
+    void toLinear( const void *nonlinear, DataType type, float *linear,
+		   size_t n, size_t inStride= 1, size_t outStride= 1 );
+    
+  protected:
+    
+    /** discard the tables, e.g. after the curve has changed */
+    void invalidateTables();
+    
+    /** table with the results for all values of an integer type
+	(built on first use, NULL if the type is not tabulated) */
+    const float *getTable( DataType type, bool linearize );
+    
+    /** conversion of n values of any type in either direction */
+    void convert( const void *in, DataType type, float *out, size_t n,
+		  size_t inStride, size_t outStride, bool linearize );
+    
+    /** the tables, for each direction (from linear, to linear) and
+	type (UByte, UShort) */
+    vector<float> tables[2][2];
+    
   };
 
 
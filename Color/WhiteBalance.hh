@@ -56,6 +56,10 @@ namespace MDA {
     /** apply whitebalance (result overwrites input) */
     void apply( Vector &color );
     
+    /** apply whitebalance to n pixels in place (stride is the distance
+	between pixels in floats) */
+    void apply( float *colors, size_t n, size_t stride= 3 );
+    
   protected:
     
     /** source color space */
@@ -0,0 +1,138 @@
+// ==========================================================================
+// $Id:$
+// conversion between YCbCr video signals and RGB
+// ==========================================================================
+// License: Internal use at UBC only! External use is a copyright violation!
+// ==========================================================================
+// (C)opyright:
+//
+// 2007-, UBC
+//
+// Creator: heidrich (Wolfgang Heidrich)
+// Email:   heidrich@cs.ubc.ca
+// ==========================================================================
+
+#ifndef COLOR_YCBCRCONVERTER_H
+#define COLOR_YCBCRCONVERTER_H
+
+/*! \file  YCbCrConverter.hh
+    \brief conversion between YCbCr video signals and RGB
+ */
+
+#ifdef _WIN32
+// this header file must be included before all the others
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+#include <stddef.h>
+
+#include "MDA/Base/Types.hh"
+
+namespace MDA {
+
+  /** \class YCbCrConverter YCbCrConverter.hh
+      conversion between YCbCr (as used by digital video and JPEG) and
+      non-linear RGB.
+
+      YCbCr is represented by integer code values (UByte or UShort) of
+      the given bit depth, e.g. 10 bit video in 16 bit words, with the
+      quantization ranges of the selected standard. RGB can be of any
+      type, with the usual normalization of integer types to [0..1].
+
+      Pixels are processed in blocks: the channels are split into
+      planes of floats, the (affine) conversion is applied to four
+      pixels at a time with SSE2, and the result is interleaved again.
+      Chroma upsampling for subsampled formats is done by
+      assembleScanline one scanline at a time, so that it can be fused
+      with the conversion.
+  */
+  class YCbCrConverter {
+
+  public:
+
+    /** the supported standards */
+    enum Standard {
+      /** ITU-R BT.601 (standard definition) */
+      BT601,
+      /** ITU-R BT.709 (HDTV) */
+      BT709,
+      /** ITU-R BT.2020 (UHDTV) */
+      BT2020,
+      /** JPEG (BT.601 coefficients with full quantization range) */
+      JPEG
+    };
+
+    /** constructor */
+    YCbCrConverter( Standard _standard= BT709, unsigned _bitDepth= 8 );
+
+    /** select the standard */
+    void setStandard( Standard _standard );
+
+    /** the standard */
+    inline Standard getStandard() const
+    {
+      return standard;
+    }
+
+    /** set the number of bits of the YCbCr code values (8..16) */
+    void setBitDepth( unsigned _bitDepth );
+
+    /** the number of bits of the YCbCr code values */
+    inline unsigned getBitDepth() const
+    {
+      return bitDepth;
+    }
+
+    /** convert n pixels of interleaved YCbCr code values to RGB
+	(returns false for unsupported types) */
+    bool toRGB( const void *ycbcr, DataType inType,
+		void *rgb, DataType outType, size_t n ) const;
+
+    /** convert n pixels of interleaved RGB to YCbCr code values
+	(returns false for unsupported types) */
+    bool fromRGB( const void *rgb, DataType inType,
+		  void *ycbcr, DataType outType, size_t n ) const;
+
+    /** assemble a 4:4:4 scanline of n interleaved YCbCr pixels from a
+	line of luma and two lines of chroma, which are blended with the
+	weights w0 and w1 (integer arithmetic, truncated). If subsampledX
+	is true, the chroma lines have half the horizontal resolution
+	(co-sited with the even luma samples), otherwise full resolution.
+	numChroma (at least 1) is the actual length of the chroma lines;
+	luma samples beyond it use the last chroma sample.
+	T is unsigned char or unsigned short */
+    template<class T>
+    static void assembleScanline( const T *y,
+				  const T *cb0, const T *cr0,
+				  const T *cb1, const T *cr1,
+				  unsigned w0, unsigned w1, bool subsampledX,
+				  T *out, size_t n, size_t numChroma );
+
+  protected:
+
+    /** recompute the conversion matrices */
+    void updateMatrices();
+
+    /** apply an affine map (3x4 matrix, row major) to n pixels stored
+	as three planes of floats (in place) */
+    static void affine( const float m[12], float *c0, float *c1, float *c2,
+			size_t n );
+
+    /** the standard */
+    Standard standard;
+
+    /** bits per code value */
+    unsigned bitDepth;
+
+    /** affine map from YCbCr code values to RGB in [0..1] */
+    float toRGBMatrix[12];
+
+    /** affine map from RGB in [0..1] to YCbCr code values */
+    float fromRGBMatrix[12];
+  };
+
+
+} /* namespace */
+
+#endif /* COLOR_YCBCRCONVERTER_H */
@@ -61,6 +61,14 @@ namespace MDA {
       Yuv[1]= 4.0*XYZ[0] / denominator; // u'
       Yuv[2]= 9.0*XYZ[1] / denominator; // v'
     }    
+    
+    /** convert n pixels from Yu'v' to XYZ (see ColorSpace) */
+    virtual void convertToXYZ( const float *in, float *out, size_t n,
+			       size_t inStride= 0, size_t outStride= 0 ) const;
+    
+    /** convert n pixels from XYZ to Yu'v' (see ColorSpace) */
+    virtual void convertFromXYZ( const float *in, float *out, size_t n,
+				 size_t inStride= 0, size_t outStride= 0 ) const;
 
   };
 
@@ -25,17 +25,34 @@
 #include <windows.h>
 #endif
 
+#include <vector>
+
 #include "MDA/LinearAlgebra/LinAlg.hh"
 #include "MDA/Array/Array.hh"
 #include "MDA/Base/ChannelList.hh"
+#include "MDA/Threading/SMPJob.hh"
 #include "SampleVector.hh"
 
 namespace MDA {
 
+  class KMeansAssignmentJob;
+
   /** \class KMeansClustering KMeansClustering.hh
-      k-means clustering of array data */
+      k-means clustering of array data.
+
+      The samples are kept in a flat structure-of-arrays store in
+      single precision. The assignment step runs in multiple threads
+      with per-job partial sums. Iterations over all samples use
+      Hamerly's bounds (an upper bound on the distance to the own
+      cluster, and a lower bound on the distance to all others) to
+      skip most distance computations. Iterations over a random subset
+      of the samples are mini-batch updates, where each mean moves
+      towards the batch mean with a learning rate of one over the
+      number of samples it has seen so far. */
   class KMeansClustering {
 
+    friend class KMeansAssignmentJob;
+
   public:
 
     /** \class ClusterStats KMeansClustering
@@ -100,10 +117,12 @@ namespace MDA {
     /** destructor */
     ~KMeansClustering();
     
-    /** a fixed number of global iterations */
+    /** a fixed number of global iterations (sampleSize> 0 selects
+	mini-batch iterations over that fraction of the samples) */
     void globalRelaxation( int numIter, double sampleSize= -1.0 );
     
-    /** globally iterate until convergence */
+    /** globally iterate until convergence (sampleSize> 0 selects
+	mini-batch iterations over that fraction of the samples) */
     void globalRelaxation( double maxError, double sampleSize= -1.0 );
       
     /** split a specific cluster along its largest eigenvector */
@@ -133,8 +152,30 @@ namespace MDA {
     
   protected:
     
-    /** find the best fitting cluster for a data point */
-    unsigned bestCluster( const Vector &sample );
+    /** copy sample i into a vector */
+    void getSample( unsigned long i, Vector &sample ) const;
+    
+    /** find the closest and second closest cluster for a sample
+	(given as dimension values), with their distances */
+    void closestClusters( const float *sample, unsigned &best,
+			  float &bestDist, float &secondDist ) const;
+    
+    /** copy the cluster means into the flat center store, and compute
+	the distances used by the bounds */
+    void prepareCenters();
+    
+    /** assign all samples (or the mini-batch) to clusters in multiple
+	threads, and compute the cluster sums and counts */
+    void assignAll();
+    
+    /** assign samples [first..last) (or batch entries, in mini-batch
+	mode) to clusters, and accumulate the cluster sums and counts */
+    void assignSamples( unsigned long first, unsigned long last,
+			double *sums, unsigned long *counts );
+    
+    /** the clusters have changed outside of the iterations
+	(invalidates the bounds and mini-batch counts) */
+    void clustersChanged();
     
     /** recompute cluster membership as well as eigen systems for each
 	cluster */
@@ -161,10 +202,85 @@ namespace MDA {
     /** cluster memberships */
     vector<unsigned> clusterIDs;
     
-  private:
+    /** sample dimension */
+    unsigned dimension;
+    
+    /** number of samples */
+    unsigned long numPoints;
+    
+    /** the samples, one plane of numPoints values per dimension */
+    vector<float> samples;
+    
+    /** number of clusters in the center store, padded to a multiple
+	of four */
+    unsigned paddedClusters;
+    
+    /** cluster means, one plane of paddedClusters values per
+	dimension */
+    vector<float> centers;
+    
+    /** whether the distance bounds are valid */
+    bool boundsValid;
+    
+    /** whether the current iteration is a mini-batch iteration */
+    bool miniBatch;
+    
+    /** upper bound of the distance of each sample to its cluster */
+    vector<float> upperBounds;
+    
+    /** lower bound of the distance of each sample to all other
+	clusters */
+    vector<float> lowerBounds;
+    
+    /** half the distance of each mean to the closest other mean */
+    vector<float> halfMinDist;
+    
+    /** distance each mean moved in the last iteration */
+    vector<float> moves;
+    
+    /** largest distance any other mean moved in the last iteration */
+    vector<float> otherMoves;
+    
+    /** samples of the current mini-batch */
+    vector<unsigned long> batch;
+    
+    /** number of samples each cluster has seen in mini-batches */
+    vector<double> batchCounts;
+    
+    /** cluster sums and counts of the current iteration */
+    vector<double> sums;
+    vector<unsigned long> counts;
+  };
+  
+  
+  /** \class KMeansAssignmentJob KMeansClustering.hh
+      multithreading job for assigning a range of samples to clusters;
+      the partial sums are added up in the reduction */
+  class KMeansAssignmentJob: public SMPJob {
+    
+  public:
+    
+    /** constructor */
+    KMeansAssignmentJob( KMeansClustering *_kmeans,
+			 unsigned long _first, unsigned long _last );
+    
+    /** assign the samples */
+    virtual void execute( int jobID );
+    
+    /** add the partial sums to the totals */
+    virtual void reduce( int jobID );
+    
+  protected:
+    
+    /** the clustering */
+    KMeansClustering *kmeans;
+    
+    /** range of samples */
+    unsigned long first, last;
     
-    /** temporary means */
-    SampleVector *tmpMeans;
+    /** partial cluster sums and counts */
+    vector<double> sums;
+    vector<unsigned long> counts;
   };
 
 } /* namespace */
@@ -34,29 +34,129 @@ namespace MDA {
 
   using namespace std;
   
-  /** \class KMeansClustering KMeansClustering.hh
-      k-means clustering of array data */
+  /** \class SampleVector SampleVector.hh
+      an array of n-dimensional samples.
+
+      Samples are either stored as individual vectors in data (which
+      is convenient for small point sets that are built incrementally),
+      or flat, with all samples having the same dimension. Flat samples
+      live in a single contiguous row-major buffer, or alias the
+      channels of an Array without any copy (the Array then has to
+      outlive the SampleVector). Flat samples are NOT visible in data,
+      which stays empty; they are accessed with get/set, getChannel and
+      getNumSamples, which also work for individually stored
+      samples. */
   class SampleVector {
     
   public:
     
-    /** default constructor */
+    /** default constructor (for individually stored samples) */
     SampleVector( unsigned long numElements= 0 )
+      : dimension( 0 ), numFlat( 0 ), sampleStride( 0 )
     {
       if( numElements> 0 )
 	data.reserve( numElements );
       data.clear();
     }
     
-    /** constructor from float Arrays */
-    SampleVector( Array<float> &a, ChannelList &ch );
+    /** constructor for flat samples of the given dimension in a
+	contiguous row-major buffer (initialized to zero) */
+    SampleVector( unsigned long numSamples, unsigned _dimension );
+    
+    /** constructor from float Arrays: by default, every pixel is
+	copied into its own vector in data; with alias==true, the
+	samples are flat and alias the channel data instead (data stays
+	empty) */
+    SampleVector( Array<float> &a, ChannelList &ch, bool alias= false );
 
-    /** constructor from double Arrays */
-    SampleVector( Array<double> &a, ChannelList &ch );
+    /** constructor from double Arrays (same semantics as for float
+	Arrays) */
+    SampleVector( Array<double> &a, ChannelList &ch, bool alias= false );
+    
+    /** copy constructor (a copy of a row-major buffer gets its own
+	buffer, array aliases keep aliasing the same array) */
+    SampleVector( const SampleVector &other );
+    
+    /** assignment operator (same semantics as the copy constructor) */
+    SampleVector &operator=( const SampleVector &other );
+    
+    /** whether the samples are stored flat */
+    inline bool isFlat() const
+    {
+      return floatChannels.size()+doubleChannels.size()> 0;
+    }
+    
+    /** number of samples */
+    inline unsigned long getNumSamples() const
+    {
+      return isFlat() ? numFlat : data.size();
+    }
+    
+    /** dimension of the samples (of the first one, if they are
+	stored individually) */
+    inline unsigned getDimension() const
+    {
+      if( isFlat() )
+	return dimension;
+      return data.size()> 0 ? data[0].getSize() : 0;
+    }
+    
+    /** component k of sample i */
+    inline double get( unsigned long i, unsigned k ) const
+    {
+      if( !floatChannels.empty() )
+	return floatChannels[k][i*sampleStride];
+      if( !doubleChannels.empty() )
+	return doubleChannels[k][i*sampleStride];
+      return data[i][k];
+    }
+    
+    /** set component k of sample i */
+    inline void set( unsigned long i, unsigned k, double value )
+    {
+      if( !floatChannels.empty() )
+	floatChannels[k][i*sampleStride]= (float)value;
+      else if( !doubleChannels.empty() )
+	doubleChannels[k][i*sampleStride]= value;
+      else
+	data[i][k]= value;
+    }
+    
+    /** copy component k of all samples into a buffer */
+    void getChannel( unsigned k, float *values ) const;
+    
+    /** the row-major buffer (NULL if the samples are not stored in
+	one) */
+    inline double *getBuffer()
+    {
+      return buffer.empty() ? NULL : &buffer[0];
+    }
     
-    /** the actual data vector */
+    /** individually stored samples (empty for flat samples) */
     vector<Vector> data;
     
+  protected:
+    
+    /** point the channel pointers to the row-major buffer */
+    void bindBuffer();
+    
+    /** dimension of the flat samples */
+    unsigned dimension;
+    
+    /** number of flat samples */
+    unsigned long numFlat;
+    
+    /** distance between two samples in a channel (in values) */
+    unsigned long sampleStride;
+    
+    /** the row-major buffer */
+    vector<double> buffer;
+    
+    /** first value of each channel, for flat float samples */
+    vector<float *> floatChannels;
+    
+    /** first value of each channel, for flat double samples */
+    vector<double *> doubleChannels;
   };
   
 } /* namespace */
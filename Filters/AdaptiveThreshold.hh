@@ -0,0 +1,151 @@
+// ==========================================================================
+// $Id:$
+// adaptive thresholding against a local mean
+// ==========================================================================
+// License: Internal use at UBC only! External use is a copyright violation!
+// ==========================================================================
+// (C)opyright:
+//
+// 2007-, UBC
+//
+// Creator: heidrich (Wolfgang Heidrich)
+// Email:   heidrich@cs.ubc.ca
+// ==========================================================================
+
+#ifndef FILTERS_ADAPTIVETHRESHOLD_H
+#define FILTERS_ADAPTIVETHRESHOLD_H
+
+/*! \file  AdaptiveThreshold.hh
+    \brief adaptive thresholding against a local mean
+ */
+
+#ifdef _WIN32
+// this header file must be included before all the others
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+#include "MDA/Threading/SMPJob.hh"
+#include "Filter.hh"
+
+namespace MDA {
+
+  // forward declaration
+  template <class T> class AdaptiveThresholdJob;
+
+
+  /** \class AdaptiveThreshold AdaptiveThreshold.hh
+      A 2D adaptive threshold (Wellner/Bradley): every pixel is
+      compared to a local mean of its neighborhood, lowered by an
+      offset, and replaced by a binary result.
+
+      The local mean is either a box mean with a given radius, or a
+      box-Gaussian with a given standard deviation, which is
+      approximated by a weighted sum of three nested boxes. Either way,
+      all box sums are read from a summed-area table of the channel,
+      so that the cost is independent of the size of the
+      neighborhood. Near the boundary, the boxes are clipped to the
+      image and renormalized. The table is built in one parallel pass
+      (rows, then column strips), and thresholding happens in a second
+      parallel pass directly in the channel.
+  */
+  template<class T>
+  class AdaptiveThreshold: public Filter<T> {
+
+  public:
+
+    /** constructor: size is the radius of the box, or the standard
+	deviation of the box-Gaussian. If relative is true, the offset
+	is a percentage of the local mean, otherwise an absolute value */
+    AdaptiveThreshold( double size, double _offset= 15.0,
+		       bool gaussian= false, bool relative= true,
+		       T _hitValue= 1.0, T _missValue= 0.0 );
+
+    /** apply the filter to a number of dimensions and channels */
+    virtual bool apply( Array<T> &a, BoundaryMethod boundary,
+			ChannelList &channels, AxisList &axes );
+
+  protected:
+
+    /** prefix sums of some lines of the channel, stored in the
+	summed-area table */
+    void sumLines( const T *data, double *table, unsigned long w,
+		   unsigned long first, unsigned long last );
+
+    /** accumulate some columns of the summed-area table */
+    void sumColumns( double *table, unsigned long w, unsigned long h,
+		     unsigned long first, unsigned long last );
+
+    /** threshold some lines of the channel */
+    void threshold( T *data, const double *table, unsigned long w,
+		    unsigned long h, unsigned long first, unsigned long last );
+
+    /** number of nested boxes */
+    int numBoxes;
+
+    /** radii and weights of the nested boxes */
+    long radii[3];
+    double weights[3];
+
+    /** factor and offset applied to the local mean */
+    double scale, offset;
+
+    /** value for pixels above the threshold */
+    T hitValue;
+
+    /** value for pixels below the threshold */
+    T missValue;
+
+    /** AdaptiveThresholdJob can execute the passes */
+    friend class AdaptiveThresholdJob<T>;
+  };
+
+
+  /** \class AdaptiveThresholdJob AdaptiveThreshold.hh
+      a range of lines (or columns) in one pass of an adaptive
+      threshold */
+  template<class T>
+  class AdaptiveThresholdJob: public SMPJob {
+
+  public:
+
+    /** the passes */
+    enum Pass { SumLines, SumColumns, Threshold };
+
+    /** constructor */
+    inline AdaptiveThresholdJob( AdaptiveThreshold<T> *_filter, Pass _pass,
+				 T *_data, double *_table,
+				 unsigned long _w, unsigned long _h,
+				 unsigned long _first, unsigned long _last )
+      : SMPJob( (_last-_first)*(_pass== SumColumns ? _h : _w)*4 ),
+	filter( _filter ), pass( _pass ), data( _data ), table( _table ),
+	w( _w ), h( _h ), first( _first ), last( _last )
+    {}
+
+    /** execute the job */
+    virtual void execute( int jobID );
+
+  protected:
+
+    /** the filter */
+    AdaptiveThreshold<T> *filter;
+
+    /** the pass */
+    Pass pass;
+
+    /** channel data */
+    T *data;
+
+    /** summed-area table */
+    double *table;
+
+    /** channel dimensions */
+    unsigned long w, h;
+
+    /** range of lines (or columns) */
+    unsigned long first, last;
+  };
+
+} /* namespace */
+
+#endif /* FILTERS_ADAPTIVETHRESHOLD_H */
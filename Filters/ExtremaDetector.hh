@@ -27,13 +27,27 @@
 #include <windows.h>
 #endif
 
+#include "MDA/Threading/SMPJob.hh"
+#include "MDA/DataAnalysis/SampleVector.hh"
 #include "Filter.hh"
 
 namespace MDA {
 
+  // forward declaration
+  template <class T> class ExtremaLineJob;
+
+
   /** \class ExtremaDetector ExtremaDetector.hh
       Finds local maxima nand minima in the array, and labels them 1
-      and 0, respectively. All other pixels get a value of 0.5. */
+      and 0, respectively. All other pixels get a value of 0.5.
+
+      The local minimum and maximum over the (2*radius+1)^n
+      neighborhood are computed together, in one van Herk/Gil-Werman
+      pass per axis (three comparisons per element and extremum,
+      independent of the radius), into two scratch buffers rather than
+      temporary channels of the array. Alternatively, findExtrema
+      returns only the extrema as a sparse list, and leaves the channel
+      untouched. */
   template<class T>
   class ExtremaDetector: public Filter<T> {
 
@@ -48,11 +62,78 @@ namespace MDA {
     virtual bool apply( Array<T> &a, BoundaryMethod boundary,
 			ChannelList &channels, AxisList &axes );
     
+    /** find the extrema of one channel. Every extremum is returned as
+	a sample with the coordinates of the pixel, its value, and its
+	label (1 for maxima, 0 for minima) */
+    bool findExtrema( Array<T> &a, unsigned channel, SampleVector &extrema,
+		      BoundaryMethod boundary, AxisList &axes );
+    
   protected:
     
+    /** compute the local minima and maxima of a channel along the
+	given axes (in parallel over the lines of each axis) */
+    void minMax( Array<T> &a, unsigned channel, BoundaryMethod boundary,
+		 AxisList &axes, T *minData, T *maxData );
+    
+    /** van Herk/Gil-Werman min and max filter of a number of lines */
+    void minMaxLines( const T *inMin, const T *inMax, T *outMin, T *outMax,
+		      const unsigned long *starts, unsigned long numLines,
+		      unsigned long incr, unsigned long numElements,
+		      BoundaryMethod boundary, T background );
+    
     /** filter radius */
     unsigned radius;
     
+    /** ExtremaLineJob can filter lines */
+    friend class ExtremaLineJob<T>;
+  };
+
+
+  /** \class ExtremaLineJob ExtremaDetector.hh
+      multithreading job for the min/max filter of a number of lines
+      along one axis */
+  template<class T>
+  class ExtremaLineJob: public SMPJob {
+
+  public:
+
+    /** constructor */
+    inline ExtremaLineJob( ExtremaDetector<T> *_detector,
+			   const T *_inMin, const T *_inMax,
+			   T *_outMin, T *_outMax,
+			   const unsigned long *_starts,
+			   unsigned long _numLines, unsigned long _incr,
+			   unsigned long _numElements,
+			   BoundaryMethod _boundary, T _background )
+      : SMPJob( _numLines*_numElements*10 ),
+	detector( _detector ), inMin( _inMin ), inMax( _inMax ),
+	outMin( _outMin ), outMax( _outMax ), starts( _starts ),
+	numLines( _numLines ), incr( _incr ), numElements( _numElements ),
+	boundary( _boundary ), background( _background )
+    {}
+
+    /** filter the lines */
+    virtual void execute( int jobID );
+
+  protected:
+
+    /** the detector */
+    ExtremaDetector<T> *detector;
+
+    /** input and output data */
+    const T *inMin, *inMax;
+    T *outMin, *outMax;
+
+    /** offsets of the first elements of the lines */
+    const unsigned long *starts;
+
+    /** number of lines, increment between elements, and number of
+	elements per line */
+    unsigned long numLines, incr, numElements;
+
+    /** boundary mode and background value */
+    BoundaryMethod boundary;
+    T background;
   };
 
 
@@ -41,6 +41,8 @@ namespace MDA {
     double edgeStopSigma; /** std. dev. of edge stopping function */
     EXPR::ExpressionSequence values; /** filter values (SeparableFilter etc.) */
     bool normalize; /** whether or not to normalize the filter */
+    double threshold; /** offset of adaptive thresholds, in percent */
+    double cornerThreshold; /** minimum response of corner detectors */
   };
   
     
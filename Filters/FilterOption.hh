@@ -64,6 +64,9 @@ enum FilterType
   ThinningFiltering,
   UnsharpMaskFiltering,
   Thinning3DFiltering,
+  AdaptiveMeanFiltering,
+  AdaptiveGaussFiltering,
+  TensorCornerFiltering,
   UndefinedFiltering // this one should always be last
 };
 
@@ -33,6 +33,8 @@
 #include "FloodFill.hh"
 #include "MedianFilter.hh"
 #include "MorphologicalOps.hh"
+#include "AdaptiveThreshold.hh"
+#include "StructureTensorCorner.hh"
 
 
 #endif /* FILTERS_FILTERS_H */
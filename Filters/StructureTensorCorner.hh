@@ -0,0 +1,186 @@
+// ==========================================================================
+// $Id:$
+// a fused, tiled structure tensor corner detector
+// ==========================================================================
+// License: Internal use at UBC only! External use is a copyright violation!
+// ==========================================================================
+// (C)opyright:
+//
+// 2007-, UBC
+//
+// Creator: heidrich (Wolfgang Heidrich)
+// Email:   heidrich@cs.ubc.ca
+// ==========================================================================
+
+#ifndef FILTERS_STRUCTURETENSORCORNER_H
+#define FILTERS_STRUCTURETENSORCORNER_H
+
+/*! \file  StructureTensorCorner.hh
+    \brief a fused, tiled structure tensor corner detector
+ */
+
+#ifdef _WIN32
+// this header file must be included before all the others
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+#include <vector>
+
+#include "MDA/Threading/SMPJob.hh"
+#include "MDA/DataAnalysis/SampleVector.hh"
+#include "Filter.hh"
+
+namespace MDA {
+
+  using namespace std;
+
+  // forward declaration
+  template <class T> class StructureTensorCornerJob;
+
+
+  /** \class StructureTensorCorner StructureTensorCorner.hh
+      A 2D corner detector based on the structure tensor
+      M= G_sigma * (Ix^2 Ix*Iy ; Ix*Iy Iy^2), with either the Harris
+      response det(M) - k*trace(M)^2, or the Shi-Tomasi response (the
+      smaller eigenvalue of M).
+
+      Unlike ImprovedHarrisCorner, all stages (central difference
+      gradients, tensor products, Gaussian smoothing, response, and
+      non-maximum suppression) are fused into one pass over tiles of
+      the image, with all intermediate results in small per-tile
+      buffers. The tiles are processed in parallel.
+
+      As a filter, the response replaces the channel. If the
+      suppression radius is positive, all pixels that are not local
+      maxima of the response within that radius, or that are not above
+      the threshold, are set to 0. Alternatively, findCorners returns
+      only the corners as a sparse list. */
+  template<class T>
+  class StructureTensorCorner: public Filter<T> {
+
+  public:
+
+    /** the corner response */
+    enum Response { Harris, ShiTomasi };
+
+    /** constructor */
+    StructureTensorCorner( double _sigma= 1.0, Response _response= Harris,
+			   double _harrisK= 0.05, double _threshold= 0.0,
+			   unsigned _suppressionRadius= 1 );
+
+    /** apply the filter to a number of dimensions and channels */
+    virtual bool apply( Array<T> &a, BoundaryMethod boundary,
+			ChannelList &channels, AxisList &axes );
+
+    /** find the corners in one channel of a 2D array. The corners are
+	returned as 3D samples (x, y, response), sorted by decreasing
+	response. A suppression radius of 0 is treated as 1 */
+    bool findCorners( Array<T> &a, unsigned channel, SampleVector &corners,
+		      BoundaryMethod boundary= Clamp );
+
+  protected:
+
+    /** process one tile [x0,x1)x[y0,y1) of a w x h channel. The
+	response (after non-maximum suppression) is either written to
+	dst, or the corners are appended to corners as (x, y, response)
+	triples */
+    void processTile( const T *src, T background, long w, long h,
+		      BoundaryMethod boundary, unsigned suppression,
+		      long x0, long y0, long x1, long y1,
+		      T *dst, vector<double> *corners );
+
+    /** process the whole channel in parallel tiles */
+    void processChannel( const T *src, T background, long w, long h,
+			 BoundaryMethod boundary, unsigned suppression,
+			 T *dst, vector<double> *corners );
+
+    /** standard deviation of the Gaussian window */
+    double sigma;
+
+    /** the corner response */
+    Response response;
+
+    /** weight of the trace term in the Harris response */
+    double harrisK;
+
+    /** response threshold for corners */
+    double threshold;
+
+    /** radius of the non-maximum suppression (0 for none) */
+    unsigned suppressionRadius;
+
+    /** radius and weights of the Gaussian window */
+    int gaussRadius;
+    vector<double> gaussWeights;
+
+    /** StructureTensorCornerJob can process tiles */
+    friend class StructureTensorCornerJob<T>;
+  };
+
+
+  /** \class StructureTensorCornerJob StructureTensorCorner.hh
+      multithreading job for one tile of a structure tensor corner
+      detector. The corners of all jobs are collected in the
+      reduction */
+  template<class T>
+  class StructureTensorCornerJob: public SMPJob {
+
+  public:
+
+    /** constructor */
+    inline StructureTensorCornerJob( StructureTensorCorner<T> *_detector,
+				     const T *_src, T _background,
+				     long _w, long _h,
+				     BoundaryMethod _boundary,
+				     unsigned _suppression,
+				     long _x0, long _y0, long _x1, long _y1,
+				     T *_dst, vector<double> *_allCorners )
+      : SMPJob( (double)(_x1-_x0)*(_y1-_y0)*
+		(30+12*_detector->gaussRadius+
+		 (2*_suppression+1)*(2*_suppression+1)) ),
+	detector( _detector ), src( _src ), background( _background ),
+	w( _w ), h( _h ), boundary( _boundary ), suppression( _suppression ),
+	x0( _x0 ), y0( _y0 ), x1( _x1 ), y1( _y1 ), dst( _dst ),
+	allCorners( _allCorners )
+    {
+      applyReduction= (allCorners!= NULL);
+    }
+
+    /** process the tile */
+    virtual void execute( int jobID );
+
+    /** append the corners of this tile to the list of all corners */
+    virtual void reduce( int jobID );
+
+  protected:
+
+    /** the detector */
+    StructureTensorCorner<T> *detector;
+
+    /** source channel, its background, and its dimensions */
+    const T *src;
+    T background;
+    long w, h;
+
+    /** boundary mode */
+    BoundaryMethod boundary;
+
+    /** suppression radius */
+    unsigned suppression;
+
+    /** the tile */
+    long x0, y0, x1, y1;
+
+    /** destination channel (NULL for a sparse result) */
+    T *dst;
+
+    /** corners of this tile, and of all tiles (NULL for a dense
+	result) */
+    vector<double> corners;
+    vector<double> *allCorners;
+  };
+
+} /* namespace */
+
+#endif /* FILTERS_STRUCTURETENSORCORNER_H */
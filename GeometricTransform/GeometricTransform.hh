@@ -22,6 +22,8 @@
 #include "GeometricTransformation.hh"
 #include "Scaling.hh"
 #include "GeneralizedShear.hh"
+#include "ProjectiveWarp.hh"
+#include "Pyramid.hh"
 
 #endif /* GEOMETRICTRANSFORM_GEOMETRICTRANSFORMATION_H */
 
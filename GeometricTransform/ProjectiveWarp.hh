@@ -0,0 +1,158 @@
+// ==========================================================================
+// $Id:$
+// direct backward warping with affine and projective matrices
+// ==========================================================================
+// License: Internal use at UBC only! External use is a copyright violation!
+// ==========================================================================
+// (C)opyright:
+//
+// 2007-, UBC
+//
+// Creator: heidrich (Wolfgang Heidrich)
+// Email:   heidrich@cs.ubc.ca
+// ==========================================================================
+
+#ifndef GEOMETRICTRANSFORM_PROJECTIVEWARP_H
+#define GEOMETRICTRANSFORM_PROJECTIVEWARP_H
+
+/*! \file  ProjectiveWarp.hh
+    \brief direct backward warping with affine and projective matrices
+ */
+
+#ifdef _WIN32
+// this header file must be included before all the others
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+#include <vector>
+
+#include "MDA/Threading/SMPJob.hh"
+#include "MDA/LinearAlgebra/LinAlg.hh"
+#include "GeometricTransformation.hh"
+
+namespace MDA {
+
+  using namespace std;
+
+  /** \class ProjectiveWarp ProjectiveWarp.hh
+      direct backward warping of an array with an affine or
+      projective matrix.
+
+      Unlike the separable transformations, every destination pixel
+      is interpolated directly from the source array, so no
+      intermediate arrays are required. The source position is
+      updated incrementally along each scanline, and the destination
+      is processed in tiles by multiple threads. The interpolation
+      kernel follows the resampler: nearest neighbor, linear, or cubic
+      (for all other resamplers). The boundary method and background
+      are also taken from the resampler. Since the source is point
+      sampled, there is no prefiltering, so strong minifications are
+      better done with Scaling.
+  */
+  template<class T>
+  class ProjectiveWarp: public GeometricTransformation<T> {
+
+  public:
+
+    /** default constructor */
+    inline ProjectiveWarp( Resampler<T> *_resampler= NULL )
+      : GeometricTransformation<T>( _resampler ), pixelSpace( false )
+    {}
+
+    /** set the homogeneous (dimension+1)x(dimension+1) matrix that
+	maps destination NDC to source NDC (i.e. the inverse of the
+	forward warp, as for the other transformations) */
+    inline void setTransform( const Matrix &m )
+    {
+      transform= m;
+      pixelSpace= false;
+    }
+
+    /** set the homogeneous matrix that maps destination pixel
+	coordinates to source pixel coordinates */
+    inline void setPixelTransform( const Matrix &m )
+    {
+      transform= m;
+      pixelSpace= true;
+    }
+
+    /** apply the transform to a single channel in one array */
+    virtual bool apply( Array<T> &srcArray, int srcChannel,
+			Array<T> &dstArray, int dstChannel );
+
+  protected:
+
+    /** homogeneous backward mapping */
+    Matrix transform;
+
+    /** whether the matrix is in pixel coordinates rather than NDC */
+    bool pixelSpace;
+
+  };
+
+
+  /** \class WarpTileJob ProjectiveWarp.hh
+      multithreading job for warping one tile of the destination
+      (a range of scanlines, restricted to a range along axis 0) */
+  template<class T>
+  class WarpTileJob: public SMPJob {
+
+  public:
+
+    /** constructor (the matrix is given in pixel coordinates, as a
+	row-major array of (dimension+1)^2 values) */
+    WarpTileJob( Resampler<T> *_resampler, unsigned _kernelWidth,
+		 const double *_matrix, bool _projective,
+		 T *_src, const CoordinateVector &_srcDim,
+		 T *_dst, const CoordinateVector &_dstDim,
+		 unsigned long _firstLine, unsigned long _numLines,
+		 unsigned long _firstX, unsigned long _lastX );
+
+    /** warp the tile */
+    virtual void execute( int threadID );
+
+  protected:
+
+    /** interpolate the source at pixel position pos */
+    T sample( const double *pos );
+
+    /** the resampler (for the boundary handling) */
+    Resampler<T> *resampler;
+
+    /** number of taps per axis (1, 2 or 4) */
+    unsigned kernelWidth;
+
+    /** the backward mapping in pixel coordinates */
+    const double *matrix;
+
+    /** whether the last row of the matrix is not (0, ..., 0, 1) */
+    bool projective;
+
+    /** source data and dimensions */
+    T *src;
+    CoordinateVector srcDim;
+
+    /** destination data and dimensions */
+    T *dst;
+    CoordinateVector dstDim;
+
+    /** range of destination scanlines */
+    unsigned long firstLine, numLines;
+
+    /** range along axis 0 (lastX is exclusive) */
+    unsigned long firstX, lastX;
+
+    /** source offset of each tap along each axis (-1 for background) */
+    vector<long> tapOffsets;
+
+    /** weight of each tap along each axis */
+    vector<double> tapWeights;
+  };
+
+
+} /* namespace */
+
+
+#endif /* GEOMETRICTRANSFORM_PROJECTIVEWARP_H */
+
@@ -0,0 +1,151 @@
+// ==========================================================================
+// $Id:$
+// multi-resolution pyramids of arrays
+// ==========================================================================
+// License: Internal use at UBC only! External use is a copyright violation!
+// ==========================================================================
+// (C)opyright:
+//
+// 2007-, UBC
+//
+// Creator: heidrich (Wolfgang Heidrich)
+// Email:   heidrich@cs.ubc.ca
+// ==========================================================================
+
+#ifndef GEOMETRICTRANSFORM_PYRAMID_H
+#define GEOMETRICTRANSFORM_PYRAMID_H
+
+/*! \file  Pyramid.hh
+    \brief multi-resolution pyramids of arrays
+ */
+
+#ifdef _WIN32
+// this header file must be included before all the others
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+#include <vector>
+
+#include "MDA/Base/CoordinateVector.hh"
+#include "Scaling.hh"
+
+namespace MDA {
+
+  using namespace std;
+
+  /** \class Pyramid Pyramid.hh
+      multi-resolution pyramid (mipmap) of all channels of an array.
+
+      Level 0 is the original data; every further level halves all
+      axes that are longer than one pixel (rounding up), with the
+      resampler acting as the prefilter. All levels are stored in a
+      single contiguous buffer, level by level, with the channels of a
+      level stored one after another.
+
+      Every level is computed from the previous one in a single batch
+      of jobs, one per channel and band of positions along the last
+      axis. Each job applies the resampler's filter taps along all
+      axes in one go, so the previous level is traversed only once,
+      and no intermediate arrays are allocated. Resamplers without tap
+      tables (e.g. nearest neighbor or min/max) fall back to a regular
+      Scaling of one channel at a time.
+  */
+  template<class T>
+  class Pyramid {
+
+  public:
+
+    /** constructor (the pyramid takes ownership of the resampler; by
+	default, a cubic resampler with clamped boundaries is used) */
+    Pyramid( Resampler<T> *_resampler= NULL );
+
+    /** build the pyramid for all channels of an array, stopping after
+	maxLevels levels (0 for no limit), or once no axis is longer
+	than minSize */
+    bool build( Array<T> &srcArray, unsigned maxLevels= 0,
+		unsigned long minSize= 1 );
+
+    /** build the pyramid from channels in a plain buffer (one channel
+	after another) */
+    bool build( const T *data, const CoordinateVector &dim,
+		unsigned numChannels, unsigned maxLevels= 0,
+		unsigned long minSize= 1 );
+
+    /** number of levels */
+    inline unsigned getNumLevels() const
+    {
+      return dims.size();
+    }
+
+    /** number of channels */
+    inline unsigned getNumChannels() const
+    {
+      return numChannels;
+    }
+
+    /** dimensions of one level */
+    inline const CoordinateVector &getDimension( unsigned level ) const
+    {
+      return dims[level];
+    }
+
+    /** number of samples per channel in one level */
+    inline unsigned long getLevelSize( unsigned level ) const
+    {
+      return levelSizes[level];
+    }
+
+    /** data of one channel in one level */
+    inline T *getLevel( unsigned level, unsigned channel )
+    {
+      return &storage[offsets[level] + channel*levelSizes[level]];
+    }
+
+    /** copy one level into a new array */
+    void getLevel( unsigned level, Array<T> &dstArray );
+
+    /** the resampler */
+    inline Resampler<T> *getResampler() const
+    {
+      return scaler.getResampler();
+    }
+
+  protected:
+
+    /** compute the level dimensions, and allocate the storage */
+    bool layout( const CoordinateVector &dim, unsigned _numChannels,
+		 unsigned maxLevels, unsigned long minSize );
+
+    /** compute levels 1 and up from level 0 */
+    bool computeLevels();
+
+    /** scaling used to compute the levels for resamplers without
+	tap tables (also owns the resampler) */
+    Scaling<T> scaler;
+
+    /** filter taps along every axis for the level being computed */
+    vector<PolyphaseTable> tables;
+
+    /** number of channels */
+    unsigned numChannels;
+
+    /** dimensions of each level */
+    vector<CoordinateVector> dims;
+
+    /** samples per channel of each level */
+    vector<unsigned long> levelSizes;
+
+    /** start of each level in the storage */
+    vector<unsigned long> offsets;
+
+    /** all levels */
+    vector<T> storage;
+  };
+
+
+} /* namespace */
+
+
+#endif /* GEOMETRICTRANSFORM_PYRAMID_H */
+
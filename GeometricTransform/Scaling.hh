@@ -57,6 +57,11 @@ namespace MDA {
     virtual bool apply( Array<T> &srcArray, int srcChannel,
 			Array<T> &dstArray, int dstChannel );
     
+    /** apply the transform to a single channel stored in a plain
+	buffer (for data that does not live in an Array) */
+    bool scale( T *srcBuf, const CoordinateVector &srcDim,
+		T *dstBuf, const CoordinateVector &dstDim );
+    
   protected:
     
     /** homogeneous scaling matrix */
@@ -49,7 +49,7 @@ namespace MDA {
      *  (if radius is 0, the standard magnification-case radius of the
      *  individual filter is used)
      */
-    virtual void setSampleLocation( Vector pos,
+    virtual void setSampleLocation( const Vector &pos,
 				    BoundaryMethod boundary );
     
     /** return sample value as extracted from specific array data */
@@ -95,6 +95,14 @@ namespace MDA {
     unsigned long calculateOffset( CoordinateVector &pos,
 				   BoundaryMethod boundary );
     
+    /** calculate the index along one axis for a given integer position
+     *  (-1 for the background)
+     *  \param pos: position along the axis
+     *  \param size: array size along the axis
+     *  \param boundary: boundary method
+     */
+    long calculateIndex( long pos, long size, BoundaryMethod boundary );
+    
     /** dimension of array */
     CoordinateVector dim;
     
@@ -114,6 +122,10 @@ namespace MDA {
     /** weights for each pixel in support */
     T *supWeights;
 
+    /** array offsets of the support pixels along each axis
+	(supWidth entries per axis, -1 for the background) */
+    long *axisOffsets;
+
     /** transient position variable (avoids repeated memory reallocation) */
     CoordinateVector currentPos;
   };
@@ -136,7 +148,7 @@ namespace MDA {
     
     /** set the location of the point sampling process - special
 	implementation for nearest neighbor */
-    virtual void setSampleLocation( Vector pos,
+    virtual void setSampleLocation( const Vector &pos,
 				    BoundaryMethod boundary );
     
     /** this method does not get called for Nearest neighbor... */
@@ -33,10 +33,62 @@
 #endif
 
 
+#include <vector>
+
 #include "MDA/Array/Boundary.hh"
 
 namespace MDA {
   
+  using namespace std;
+  
+  /** \class PolyphaseTable Resampler.hh
+   precomputed filter taps (input positions and normalized weights)
+   for every output sample of a linear resampling operation */
+  class PolyphaseTable {
+    
+  public:
+    
+    /** default constructor (creates an empty table) */
+    PolyphaseTable()
+    : inCount( 0 ), outCount( 0 ), a( 0.0 ), b( 0.0 ),
+      boundary( Background )
+    {}
+    
+    /** whether the table was built for the given parameters */
+    inline bool matches( unsigned long _inCount, unsigned long _outCount,
+                         double _a, double _b,
+                         BoundaryMethod _boundary ) const
+    {
+      return outCount> 0 && inCount== _inCount && outCount== _outCount &&
+        a== _a && b== _b && boundary== _boundary;
+    }
+    
+    /** mark the table as outdated */
+    inline void invalidate()
+    {
+      outCount= 0;
+    }
+    
+    /** parameters the table was built for */
+    unsigned long inCount, outCount;
+    double a, b;
+    BoundaryMethod boundary;
+    
+    /** index of the first tap of every output sample (outCount+1
+     entries, so that the taps of sample i end at tapStart[i+1]) */
+    vector<unsigned long> tapStart;
+    
+    /** input positions of all taps (boundary conditions resolved) */
+    vector<long> tapIndex;
+    
+    /** normalized weights of all taps */
+    vector<double> tapWeight;
+    
+    /** normalized weight of the background color for every sample */
+    vector<double> backgroundWeight;
+  };
+  
+  
   /** \class Resampler Resampler.hh
    Virtual base class for resampling filters */
   template<class T>
@@ -74,10 +126,43 @@ namespace MDA {
       return boundary;
     }
     
+    /** return the background color */
+    inline T getBackground()
+    {
+      return background;
+    }
+    
+    /** input position that a position outside the line maps to
+     (-1 for the background) */
+    long getBoundaryIndex( long inCount, long pos );
+    
     /** get a pixel from the boundary */
     T getBoundaryPixel( T *inLine, long inCount,
 			long inStride, long pos );
     
+    /** precompute the filter taps of resampleLinear for one set of
+     parameters. Subsequent calls to resampleLinear with the same
+     parameters just apply the table, which is safe from multiple
+     threads (but the table itself has to be prepared before the
+     threads start). Returns false if the filter is not tabulated */
+    bool prepareLinear( unsigned long inCount, unsigned long outCount,
+                        double a, double b );
+    
+    /** the table built by the last successful prepareLinear call (for
+     code that applies the same taps to its own data layout) */
+    inline const PolyphaseTable &getLinearTable() const
+    {
+      return linearTable;
+    }
+    
+    /** whether resampleLinear is a fixed weighted sum of input samples
+     that prepareLinear can tabulate (false for nearest neighbor,
+     min/max, and other filters that are evaluated directly) */
+    inline bool supportsLinearTable()
+    {
+      return linearSupport( 1.0 )> 0.0;
+    }
+    
     /** resample a scanline/column with linear function oldX= a*newX + b
      
      (the default implementation is to use resampleIrregular, but
@@ -90,6 +175,18 @@ namespace MDA {
 				 unsigned long outStride,
 				 double a, double b );
     
+    /** resample numLines adjacent columns with the same linear
+     function (column k starts at inLine+k and outLine+k). With a
+     prepared table, every filter tap is applied to the whole panel
+     of columns at once, so the inner loop runs over contiguous
+     memory; otherwise the columns are resampled one by one */
+    void resampleLinearPanel( T *inLine, unsigned long inCount,
+                              unsigned long inStride, T *outLine,
+                              unsigned long outCount,
+                              unsigned long outStride,
+                              unsigned long numLines,
+                              double a, double b );
+    
     /** resample a scanline/column with rational function
      oldX = (a*newX + b) / (c*newX + d)
      
@@ -113,12 +210,36 @@ namespace MDA {
     
   protected:
     
+    /** support radius of the filter for resampleLinear with scale a
+     (0 for filters that are not tabulated) */
+    virtual double linearSupport( double a )
+    {
+      return 0.0;
+    }
+    
+    /** unnormalized filter weight for resampleLinear with scale a, at
+     distance dist between sample position and input pixel */
+    virtual double linearWeight( double dist, double a )
+    {
+      return 0.0;
+    }
+    
+    /** resample a line with the polyphase table, if the table was
+     prepared for these parameters (otherwise returns false) */
+    bool applyLinearTable( T *inLine, unsigned long inCount,
+                           unsigned long inStride, T *outLine,
+                           unsigned long outCount, unsigned long outStride,
+                           double a, double b );
+    
     /** mode for dealing with boundaries */
     BoundaryMethod boundary;
     
     /** value to be used as background in Background boundary mode */
     T background;
     
+    /** filter taps prepared for resampleLinear */
+    PolyphaseTable linearTable;
+    
   };
   
   
@@ -214,6 +335,14 @@ namespace MDA {
 				    double *outSamples,
 				    unsigned long sampleStride= 1ul );
     
+  protected:
+    
+    /** support radius of the hat function for resampleLinear */
+    virtual double linearSupport( double a );
+    
+    /** hat function weight for resampleLinear */
+    virtual double linearWeight( double dist, double a );
+    
   };
   
   
@@ -246,6 +375,14 @@ namespace MDA {
 				    double *outSamples,
 				    unsigned long sampleStride= 1ul );
     
+  protected:
+    
+    /** support radius of the cubic for resampleLinear */
+    virtual double linearSupport( double a );
+    
+    /** cubic weight for resampleLinear */
+    virtual double linearWeight( double dist, double a );
+    
   };
   
   
@@ -275,6 +412,7 @@ namespace MDA {
         sigma= _sigma;
       
       multiplier= -1.0 / (2.0 * sigma * sigma);
+      this->linearTable.invalidate();
     }
     
     /** linear resampling (oldX= a*newX + b) with Gaussian reconstruction*/
@@ -295,6 +433,12 @@ namespace MDA {
     
   protected:
     
+    /** support radius of the Gaussian for resampleLinear */
+    virtual double linearSupport( double a );
+    
+    /** Gaussian weight for resampleLinear */
+    virtual double linearWeight( double dist, double a );
+    
     /** standard deviation */
     double sigma;
     
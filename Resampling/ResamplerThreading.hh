@@ -81,6 +81,37 @@ namespace MDA {
   };
   
   
+  /** \class PanelResamplerJob Resampler.hh
+   *  multithreading job for linear resampling of a panel of adjacent
+   *  columns (for convenience, this is just subclassed from the
+   *  linear case)
+   */
+  template <class T>
+  class PanelResamplerJob: public LinearResamplerJob<T> {
+    
+  public:
+    
+    /** constructor */
+    PanelResamplerJob( Resampler<T> *_resampler, T* _inLine,
+		       unsigned long _inCount, unsigned long _inStride,
+		       T* _outLine, unsigned long _outCount,
+		       unsigned long _outStride, unsigned long _numLines,
+		       double _a, double _b )
+      : LinearResamplerJob<T>( _resampler, _inLine, _inCount, _inStride,
+			       _outLine, _outCount, _outStride, _a, _b ),
+	numLines( _numLines )
+    {}
+    
+    /** resample the panel */
+    virtual void execute( int threadID );
+    
+  public:
+    
+    /** number of adjacent columns */
+    unsigned long numLines;
+  };
+  
+  
   /** \class RationalResamplerJob Resampler.hh
    *  multithreading job for rational resampling of a data line
    *  (for convenience, this is just subclassed from the linear case)
@@ -0,0 +1,162 @@
+// ==========================================================================
+// $Id:$
+// a bounded producer/consumer queue for pipelines of threads
+// ==========================================================================
+// License: Internal use at UBC only! External use is a copyright violation!
+// ==========================================================================
+// (C)opyright:
+//
+// 2007-, UBC
+//
+// Creator: heidrich (Wolfgang Heidrich)
+// Email:   heidrich@cs.ubc.ca
+// ==========================================================================
+
+#ifndef THREADING_BOUNDEDQUEUE_H
+#define THREADING_BOUNDEDQUEUE_H
+
+/*! \file  BoundedQueue.hh
+    \brief a bounded producer/consumer queue for pipelines of threads
+ */
+
+#ifdef _WIN32
+// this header file must be included before all the others
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+#include <deque>
+#ifdef HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
+
+namespace MDA {
+
+  using namespace std;
+
+  /** \class BoundedQueue BoundedQueue.hh
+      a FIFO queue between the stages of a pipeline. Producers wait
+      while the queue is full (which bounds the look-ahead of the
+      producing stage), and consumers wait while it is empty. Closing
+      the queue wakes everybody up: further pushes fail, and pops fail
+      once the queue has been drained.
+
+      Without pthreads, the queue is a plain FIFO that never blocks,
+      and the stages have to be run in turn by the caller */
+  template<class T>
+  class BoundedQueue {
+
+  public:
+
+    /** constructor */
+    BoundedQueue( unsigned long _capacity )
+      : capacity( _capacity> 0 ? _capacity : 1 ), closed( false )
+    {
+#ifdef HAVE_PTHREADS
+      pthread_mutex_init( &mutex, NULL );
+      pthread_cond_init( &notEmpty, NULL );
+      pthread_cond_init( &notFull, NULL );
+#endif
+    }
+
+    /** destructor */
+    ~BoundedQueue()
+    {
+#ifdef HAVE_PTHREADS
+      pthread_cond_destroy( &notFull );
+      pthread_cond_destroy( &notEmpty );
+      pthread_mutex_destroy( &mutex );
+#endif
+    }
+
+    /** append an element, waiting while the queue is full. Returns
+	false if the queue has been closed */
+    bool push( const T &element )
+    {
+#ifdef HAVE_PTHREADS
+      pthread_mutex_lock( &mutex );
+      while( !closed && elements.size()>= capacity )
+	pthread_cond_wait( &notFull, &mutex );
+      bool success= !closed;
+      if( success )
+      {
+	elements.push_back( element );
+	pthread_cond_signal( &notEmpty );
+      }
+      pthread_mutex_unlock( &mutex );
+      return success;
+#else
+      if( closed )
+	return false;
+      elements.push_back( element );
+      return true;
+#endif
+    }
+
+    /** remove the first element, waiting while the queue is
+	empty. Returns false if the queue is closed and empty */
+    bool pop( T &element )
+    {
+#ifdef HAVE_PTHREADS
+      pthread_mutex_lock( &mutex );
+      while( !closed && elements.empty() )
+	pthread_cond_wait( &notEmpty, &mutex );
+      bool success= !elements.empty();
+      if( success )
+      {
+	element= elements.front();
+	elements.pop_front();
+	pthread_cond_signal( &notFull );
+      }
+      pthread_mutex_unlock( &mutex );
+      return success;
+#else
+      if( elements.empty() )
+	return false;
+      element= elements.front();
+      elements.pop_front();
+      return true;
+#endif
+    }
+
+    /** close the queue (no more elements can be pushed) */
+    void close()
+    {
+#ifdef HAVE_PTHREADS
+      pthread_mutex_lock( &mutex );
+      closed= true;
+      pthread_cond_broadcast( &notEmpty );
+      pthread_cond_broadcast( &notFull );
+      pthread_mutex_unlock( &mutex );
+#else
+      closed= true;
+#endif
+    }
+
+  protected:
+
+    /** the queued elements */
+    deque<T> elements;
+
+    /** maximum number of queued elements */
+    unsigned long capacity;
+
+    /** whether the queue has been closed */
+    bool closed;
+
+#ifdef HAVE_PTHREADS
+    /** lock for all members */
+    pthread_mutex_t mutex;
+
+    /** signalled when an element has been pushed, or the queue closed */
+    pthread_cond_t notEmpty;
+
+    /** signalled when an element has been popped, or the queue closed */
+    pthread_cond_t notFull;
+#endif
+  };
+
+} /* namespace */
+
+#endif /* THREADING_BOUNDEDQUEUE_H */
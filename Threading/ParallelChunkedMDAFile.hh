@@ -0,0 +1,83 @@
+// ==========================================================================
+// $Id:$
+// chunked MDA files with multithreaded chunk compression
+// ==========================================================================
+// License: Internal use at UBC only! External use is a copyright violation!
+// ==========================================================================
+// (C)opyright:
+//
+// 2007-, UBC
+//
+// Creator: heidrich (Wolfgang Heidrich)
+// Email:   heidrich@cs.ubc.ca
+// ==========================================================================
+
+#ifndef THREADING_PARALLELCHUNKEDMDAFILE_H
+#define THREADING_PARALLELCHUNKEDMDAFILE_H
+
+/*! \file  ParallelChunkedMDAFile.hh
+    \brief chunked MDA files with multithreaded chunk compression
+ */
+
+#ifdef _WIN32
+// this header file must be included before all the others
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+#include "MDA/Base/ChunkedMDAFile.hh"
+#include "SMPJobManager.hh"
+
+
+namespace MDA {
+
+  using namespace std;
+
+  /** \class ParallelChunkedMDAWriter ParallelChunkedMDAFile.hh
+      writer for chunked MDA files that buffers a batch of chunks and
+      compresses them with one SMPJob per chunk. The file format is
+      the same as for ChunkedMDAWriter */
+  class ParallelChunkedMDAWriter: public ChunkedMDAWriter {
+
+  public:
+
+    /** constructor */
+    ParallelChunkedMDAWriter( ChunkCompression compression=
+			      ZStdChunkCompression,
+			      int level= 3,
+			      unsigned long scanlinesPerChunk= 0,
+			      unsigned long chunksPerBatch= 8 );
+
+    /** destructor (closes the file if required) */
+    virtual ~ParallelChunkedMDAWriter();
+
+  protected:
+
+    /** compress the buffered chunks in parallel */
+    virtual void compressChunks( unsigned long count );
+  };
+
+
+  /** \class ParallelChunkedMDAReader ParallelChunkedMDAFile.hh
+      reader for chunked MDA files that decompresses a batch of
+      consecutive chunks with one SMPJob per chunk */
+  class ParallelChunkedMDAReader: public ChunkedMDAReader {
+
+  public:
+
+    /** constructor */
+    ParallelChunkedMDAReader( unsigned long chunksPerBatch= 8 );
+
+  protected:
+
+    /** decompress a batch of chunks in parallel */
+    virtual bool decompressChunks( unsigned long first,
+				   unsigned long count );
+  };
+
+
+} /* namespace */
+
+
+
+#endif /* THREADING_PARALLELCHUNKEDMDAFILE_H */
@@ -59,9 +59,9 @@ namespace MDA {
     }
     
     /** batch a list of jobs for execution & block until termination
-     *  Use serial execution if job list not previously empty The job
-     *  manager removes all jobs from the JobList, and returns it
-     *  empty.
+     *  Use serial execution if job list not previously empty, or if
+     *  called from within a job. The job manager removes all jobs
+     *  from the JobList, and returns it empty.
      */
     void batch( SMPJobList &jobs );
     
@@ -119,6 +119,10 @@ namespace MDA {
     
     /** condition varialble to signal that all batch jobs are done */
     static pthread_cond_t *allThreadsIdle;
+    
+    /** thread-specific key that is set in the worker threads, so that
+	batches issued from within a job are executed serially */
+    static pthread_key_t workerKey;
 #endif
   };
 